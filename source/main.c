@@ -105,6 +105,37 @@
 
 #include "flecs/flecs.h" 
 
+#include <float.h>
+#include <stddef.h>
+
+#if (defined __SSE__ || defined _M_X64)
+    #include <xmmintrin.h>
+    #define BSF_SIMD_SSE
+#endif
+
+// Render commands are built on their own thread and CPU jobs run on a pool where pthreads are available (not html5/msvc)
+#if !(defined __EMSCRIPTEN__ || defined _MSC_VER)
+    #include <pthread.h>
+    #include <unistd.h>
+    #define BSF_RENDER_THREAD
+    #define BSF_JOB_THREADS
+#endif
+
+// Asset pack is mapped where mmap is available, read into memory elsewhere
+#if (defined __linux__ || defined __APPLE__) && !defined __EMSCRIPTEN__
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #define BSF_ASSET_PACK_MMAP
+#endif
+
+// Asset files are watched for hot reload where inotify is available
+#if defined __linux__ && !defined __EMSCRIPTEN__
+    #include <sys/inotify.h>
+    #include <unistd.h>
+    #define BSF_ASSET_WATCH
+#endif
+
 // Defines
 #define BSF_SEED_MAX_LEN    (8 + 1)
 #define BSF_ROOM_MAX_COLS   9
@@ -121,6 +152,48 @@ struct bsf_t;
 typedef ecs_world_t bsf_ecs_t;
 typedef ecs_entity_t bsf_entity_t;
 
+//=== BSF Jobs ===//
+
+#define BSF_JOB_THREADS_MAX     8
+
+typedef void (*bsf_job_func_t)(void* data);
+
+typedef struct
+{
+    bsf_job_func_t func;
+    void* data;
+} bsf_job_t;
+
+// Worker pool for CPU only work (no gs/GL calls), jobs run inline on push without threads
+typedef struct
+{
+    gs_dyn_array(bsf_job_t) queue;
+    uint32_t next;                          // Next job to hand out
+    uint32_t running;                       // Jobs handed out and not yet finished
+    uint32_t thread_count;
+#ifdef BSF_JOB_THREADS
+    pthread_t threads[BSF_JOB_THREADS_MAX];
+    pthread_mutex_t lock;
+    pthread_cond_t work;
+    pthread_cond_t done;
+    bool32 quit;
+#endif
+} bsf_jobs_t;
+
+GS_API_DECL void bsf_jobs_init(bsf_jobs_t* jobs);
+GS_API_DECL void bsf_jobs_push(bsf_jobs_t* jobs, bsf_job_func_t func, void* data);
+GS_API_DECL void bsf_jobs_wait(bsf_jobs_t* jobs);      // Until all pushed jobs are finished
+GS_API_DECL void bsf_jobs_free(bsf_jobs_t* jobs);
+
+// Flags a job sets for the main thread to poll, without waiting on the whole pool
+#ifdef BSF_JOB_THREADS
+    #define BSF_ATOMIC_STORE(PTR, V)    __atomic_store_n((PTR), (V), __ATOMIC_RELEASE)
+    #define BSF_ATOMIC_LOAD(PTR)        __atomic_load_n((PTR), __ATOMIC_ACQUIRE)
+#else
+    #define BSF_ATOMIC_STORE(PTR, V)    (*(PTR) = (V))
+    #define BSF_ATOMIC_LOAD(PTR)        (*(PTR))
+#endif
+
 //=== BSF Graphics ===//
 
 typedef struct
@@ -151,24 +224,227 @@ typedef enum
 
 typedef gs_gfxt_material_t bsf_material_instance_t; 
 
+#define BSF_MESH_LOD_MAX    4
+
+// Detail levels for a mesh, level 0 is the source mesh. Level i is used while the projected 
+// bounding radius (fraction of half viewport height) is at least sizes[i], last level otherwise
+typedef struct
+{
+    gs_gfxt_mesh_t* levels[BSF_MESH_LOD_MAX];
+    float sizes[BSF_MESH_LOD_MAX];
+    uint32_t count;
+} bsf_mesh_lod_t;
+
 typedef struct
 {
     gs_gfxt_material_t* material;   // Material instance of parent material
     gs_gfxt_mesh_t* mesh;		    // Handle to gfxt mesh
     gs_mat4 model;				    // Model matrix to be uploaded to GPU
+    gs_vec4 tint;                   // Per instance color multiplier (left zero in desc for white)
+    gs_vec4 flash;                  // Per instance flash color (rgb) blended over the result by a, hit flashes
+    gs_vec4 bounds;                 // Local bounding sphere (xyz center, w radius), filled from mesh if left zero
+    const bsf_mesh_lod_t* lod;      // Detail levels of mesh (NULL if none), mesh is reselected from these every frame
+    bool32 hidden;                  // Owned by a world snapshot, not drawn
 } bsf_renderable_t;
 
 typedef bsf_renderable_t bsf_renderable_desc_t;
 
+// Sort key layout (msb -> lsb): pipeline (16) | material (16) | mesh (16) | depth (16)
+#define BSF_RENDER_KEY_PIPELINE_SHIFT   48
+#define BSF_RENDER_KEY_MATERIAL_SHIFT   32
+#define BSF_RENDER_KEY_MESH_SHIFT       16
+#define BSF_RENDER_QUEUE_MAX_IDS        256
+
+typedef struct
+{
+    uint64_t key;
+    bsf_renderable_t* rend;
+} bsf_render_item_t;
+
+typedef struct
+{
+    uint32_t draws;
+    uint32_t instances;
+    uint32_t lods[BSF_MESH_LOD_MAX];        // Renderables queued per detail level
+    uint32_t pipeline_binds;
+    uint32_t mesh_binds;
+} bsf_render_queue_stats_t;
+
+typedef struct
+{
+    bsf_render_item_t* items;       // Queued renderables, sorted by key after bsf_render_queue_sort
+    bsf_render_item_t* tmp;         // Scratch buffer for radix sort
+    uint32_t count;
+    uint32_t capacity;
+
+    // Per frame ids for key fields, assigned in order of first use
+    const void* pipelines[BSF_RENDER_QUEUE_MAX_IDS];
+    const void* materials[BSF_RENDER_QUEUE_MAX_IDS];
+    const void* meshes[BSF_RENDER_QUEUE_MAX_IDS];
+    uint32_t pipeline_count;
+    uint32_t material_count;
+    uint32_t mesh_count;
+
+    bsf_render_queue_stats_t stats;
+} bsf_render_queue_t;
+
+GS_API_DECL void bsf_render_queue_clear(bsf_render_queue_t* queue);
+GS_API_DECL void bsf_render_queue_push(bsf_render_queue_t* queue, bsf_renderable_t* rend, float depth);   // depth normalized to [0, 1]
+GS_API_DECL void bsf_render_queue_sort(bsf_render_queue_t* queue);
+GS_API_DECL void bsf_render_queue_free(bsf_render_queue_t* queue);
+
+// Per instance data, layout matches trailing attributes of *_instanced.sf (a_model0-3, a_tint, a_flash)
+typedef struct
+{
+    gs_mat4 model;
+    gs_vec4 tint;
+    gs_vec4 flash;
+} bsf_render_instance_t;
+
+#define BSF_RENDER_INSTANCE_ATTR_COUNT      6
+#define BSF_RENDER_INSTANCED_PIPELINE_MAX   8
+
+typedef struct
+{
+    const gs_gfxt_pipeline_t* pipelines[BSF_RENDER_INSTANCED_PIPELINE_MAX];    // Pipelines that have an instanced twin
+    gs_gfxt_pipeline_t* instanced[BSF_RENDER_INSTANCED_PIPELINE_MAX];
+    uint32_t count;
+    gs_dyn_array(gs_handle(gs_graphics_vertex_buffer_t)) vbos;                 // One per group drawn in a frame, reused across frames
+    bsf_render_instance_t* data;                                                // Staging for instance buffer uploads
+    uint32_t capacity;
+} bsf_render_instancing_t;
+
+GS_API_DECL void bsf_graphics_pipeline_make_instanced(gs_gfxt_pipeline_t* pip);
+GS_API_DECL bool32 bsf_graphics_pipeline_ublock_equal(const gs_gfxt_pipeline_t* a, const gs_gfxt_pipeline_t* b);
+GS_API_DECL void bsf_render_instancing_register(bsf_render_instancing_t* inst, const gs_gfxt_pipeline_t* pip, gs_gfxt_pipeline_t* instanced);
+GS_API_DECL gs_gfxt_pipeline_t* bsf_render_instancing_get(const bsf_render_instancing_t* inst, const gs_gfxt_pipeline_t* pip);
+GS_API_DECL void bsf_render_instancing_reserve(bsf_render_instancing_t* inst, uint32_t count);     // Main thread only
+GS_API_DECL void bsf_render_instancing_free(bsf_render_instancing_t* inst);
+
+typedef struct
+{
+    uint32_t visible;
+    uint32_t culled;
+} bsf_render_cull_stats_t;
+
+// World space bounding spheres of all renderables as SoA, tested 4 at a time against frustum planes
+typedef struct
+{
+    float* x;
+    float* y;
+    float* z;
+    float* r;
+    bsf_renderable_t** rends;
+    uint8_t* visible;               // Result of last test per renderable
+    uint32_t count;
+    uint32_t capacity;
+    gs_vec4 planes[6];
+    bsf_render_cull_stats_t stats;
+} bsf_render_cull_t;
+
+GS_API_DECL void bsf_render_cull_clear(bsf_render_cull_t* cull, const gs_mat4* vp);
+GS_API_DECL void bsf_render_cull_push(bsf_render_cull_t* cull, bsf_renderable_t* rend);
+GS_API_DECL void bsf_render_cull_test(bsf_render_cull_t* cull);
+GS_API_DECL void bsf_render_cull_free(bsf_render_cull_t* cull);
+
+// Per frame camera data, shared by all scene pipelines through the u_camera block (std140)
+typedef struct
+{
+    gs_mat4 view;
+    gs_mat4 proj;
+} bsf_camera_uniforms_t;
+
+#define BSF_CAMERA_UBO_BINDING  0
+
+// Immediate shapes are collected each frame and drawn as instanced unit meshes (tint carries the shape color)
+typedef struct
+{
+    bsf_shape_type shape;
+    bsf_renderable_t rend;
+    gs_gfxt_texture_t tex;
+} bsf_render_immediate_t;
+
+typedef struct
+{
+    gs_vec3 position;
+    gs_vec2 uv;
+    gs_color_t color;
+} bsf_shape_vert_t;       // Matches gsi.sf layout
+
+typedef struct
+{
+    bsf_render_queue_stats_t queue;
+    bsf_render_cull_stats_t cull;
+    float encode_ms;                // Time to record the scene command buffer
+} bsf_render_stats_t;
+
+#define BSF_RENDER_FRAME_MATERIAL_MAX   64
+
+// Render state copied out of the simulation at the end of a frame (extract), everything the scene build reads
+typedef struct
+{
+    gs_command_buffer_t cb;                                 // Scene pass, recorded by the render thread
+    gs_command_buffer_t overlay;                            // gsi and gui pass, recorded on main thread during extract
+    gs_dyn_array(bsf_renderable_t) renderables;             // Copies of all scene renderables not hidden
+    gs_dyn_array(bsf_render_immediate_t) immediates;
+    gs_dyn_array(bsf_render_instance_t) particles;          // Instances of all live particles
+    gs_gfxt_texture_t particle_tex;
+    gs_camera_t camera;
+    gs_vec2 fbs;
+    bool32 play;                                            // Scene is only drawn in play state
+    int16_t movement_type;                                  // Of current room, selects world geometry
+    gs_vec3 scroll;                                         // Rail ground scroll
+    bsf_render_stats_t stats;                               // Filled when built
+
+    // Copies of every material drawn, renderables point here. The render thread sets per draw uniforms on these, 
+    // simulation keeps writing the asset table's materials.
+    const gs_gfxt_material_t* material_srcs[BSF_RENDER_FRAME_MATERIAL_MAX];
+    gs_gfxt_material_t materials[BSF_RENDER_FRAME_MATERIAL_MAX];
+    uint32_t material_count;
+} bsf_render_frame_t;
+
+// Double buffered frames: main thread extracts frame N+1 while the render thread builds frame N
+typedef struct
+{
+    bsf_render_frame_t frames[2];
+    uint32_t extract;                                       // Index of frame filled by main thread
+    bool32 pending;                                         // Other frame is built (or being built) and not yet submitted
+#ifdef BSF_RENDER_THREAD
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bsf_render_frame_t* job;                                // Frame handed to render thread, NULL once built
+    bool32 quit;
+#endif
+} bsf_render_frames_t;
+
 typedef struct
 {
 	gs_slot_array(bsf_renderable_t) renderables;         // Collection of renderables for a graphics scene
     bsf_camera_t camera;
+    gs_handle(gs_graphics_uniform_buffer_t) camera_ubo;  // Updated once per frame from camera
+    bsf_render_queue_t queue;                            // Rebuilt every frame from renderables
+    bsf_render_instancing_t instancing;                  // Instanced twins of pipelines and instance buffers
+    bsf_render_cull_t cull;                              // Frustum culling before renderables are queued
+    gs_dyn_array(bsf_render_immediate_t) immediates;     // Pushed by immediate system, handed to the frame at extract
+    gs_dyn_array(bsf_render_item_t) immediate_items;     // Scratch for grouping immediates
+    gs_gfxt_mesh_t shapes[BSF_SHAPE_ROOM];               // Unit meshes for each immediate shape
+    bsf_render_frames_t frames;                          // Frame packets handed between main and render thread
+    bsf_render_stats_t stats;                            // Of last submitted frame
 } bsf_graphics_scene_t;
 
 GS_API_DECL uint32_t bsf_graphics_scene_renderable_create(bsf_graphics_scene_t* scene, const bsf_renderable_desc_t* desc); 
 GS_API_DECL void bsf_graphics_scene_renderable_destroy(bsf_graphics_scene_t* scene, uint32_t hndl);
 GS_API_DECL void bsf_graphics_render(struct bsf_t* bsf);
+GS_API_DECL void bsf_graphics_frames_init(bsf_graphics_scene_t* scene);
+GS_API_DECL void bsf_graphics_frames_free(bsf_graphics_scene_t* scene);
+GS_API_DECL void bsf_graphics_camera_update(gs_command_buffer_t* cb, bsf_graphics_scene_t* scene, gs_camera_t* cam, gs_vec2 fbs);
+GS_API_DECL void bsf_graphics_camera_bind(gs_command_buffer_t* cb, const bsf_graphics_scene_t* scene);   // After every pipeline bind
+GS_API_DECL void bsf_graphics_shapes_create(bsf_graphics_scene_t* scene);
+GS_API_DECL void bsf_graphics_shapes_free(bsf_graphics_scene_t* scene);
+GS_API_DECL gs_gfxt_mesh_t bsf_graphics_mesh_placeholder(const gs_gfxt_pipeline_t* pip);   // Unit cube in the mesh layout of pip
+GS_API_DECL void bsf_graphics_scene_immediate_push(bsf_graphics_scene_t* scene, bsf_shape_type shape, gs_gfxt_material_t* material, 
+        const gs_mat4* model, gs_color_t color, gs_gfxt_texture_t tex);
 
 //=== BSF Components ===// 
 
@@ -182,16 +458,14 @@ typedef struct
 	uint32_t hndl;		            // Handle to a renderable in bsf graphics scene
 } bsf_component_renderable_t;
 
+GS_API_DECL void bsf_component_renderable_ctor(ecs_world_t* world, ecs_entity_t comp, const ecs_entity_t* ent, void* ptr, size_t sz, int32_t count, void* ctx);
 GS_API_DECL void bsf_component_renderable_dtor(ecs_world_t* world, ecs_entity_t comp, const ecs_entity_t* ent, void* ptr, size_t sz, int32_t count, void* ctx);
+GS_API_DECL void bsf_component_renderable_copy(ecs_world_t* world, ecs_entity_t comp, const ecs_entity_t* dst_ent, const ecs_entity_t* src_ent, 
+        void* dst_ptr, const void* src_ptr, size_t sz, int32_t count, void* ctx);
+GS_API_DECL void bsf_component_renderable_move(ecs_world_t* world, ecs_entity_t comp, const ecs_entity_t* dst_ent, const ecs_entity_t* src_ent, 
+        void* dst_ptr, void* src_ptr, size_t sz, int32_t count, void* ctx);
 GS_API_DECL void bsf_renderable_system(ecs_iter_t* it);
 
-enum 
-{
-    BSF_RENDERABLE_IMMEDIATE_BLEND_ENABLE     = (1 << 0), 
-    BSF_RENDERABLE_IMMEDIATE_DEPTH_ENABLE     = (1 << 1), 
-    BSF_RENDERABLE_IMMEDIATE_FACE_CULL_ENABLE = (1 << 2) 
-};
-
 typedef struct
 {
     bsf_shape_type shape;
@@ -199,7 +473,6 @@ typedef struct
     gs_mat4 model; 
     gs_color_t color;
     gs_gfxt_texture_t* texture;
-    uint32_t opt;
 } bsf_component_renderable_immediate_t;
 
 GS_API_DECL void bsf_renderable_immediate_system(ecs_iter_t* it);
@@ -223,16 +496,28 @@ typedef struct
 	gs_vqs xform;
 } bsf_physics_collider_t;
 
+// Integrated every frame, kept small so movement loops only stream velocity data
 typedef struct
 {
     gs_vec3 velocity;
     gs_vec3 angular_velocity;
     float speed;
+} bsf_component_velocity_t;
+
+// Only touched for collision tests
+typedef struct
+{
     bsf_physics_collider_t collider;
-} bsf_component_physics_t;
+    gs_sphere_t bounds;     // Baked world space bounding sphere (r == 0 if not yet baked)
+    gs_vec3 offset;         // Of bounds center from the translation, rebaked only when rotation or scale change
+    gs_quat rotation;       // Rotation and scale offset was baked for
+    gs_vec3 scale;
+} bsf_component_collider_t;
 
 GS_API_DECL void bsf_physics_debug_draw_system(ecs_iter_t* it);
-GS_API_DECL gs_contact_info_t bsf_component_physics_collide(const bsf_component_physics_t* c0, const gs_vqs* xform0, const bsf_component_physics_t* c1, 
+GS_API_DECL void bsf_collider_bounds_system(ecs_iter_t* it);
+GS_API_DECL void bsf_component_collider_bake(bsf_component_collider_t* cc, const gs_vqs* xform);
+GS_API_DECL gs_contact_info_t bsf_component_physics_collide(const bsf_component_collider_t* c0, const gs_vqs* xform0, const bsf_component_collider_t* c1, 
         const gs_vqs* xform1);
 
 typedef struct
@@ -416,12 +701,16 @@ typedef struct
 } bsf_component_ai_t; 
 
 GS_API_DECL void bsf_component_ai_dtor(ecs_world_t* world, ecs_entity_t comp, const ecs_entity_t* ent, void* ptr, size_t sz, int32_t count, void* ctx);
+GS_API_DECL void bsf_component_ai_copy(ecs_world_t* world, ecs_entity_t comp, const ecs_entity_t* dst_ent, const ecs_entity_t* src_ent, 
+        void* dst_ptr, const void* src_ptr, size_t sz, int32_t count, void* ctx);
+GS_API_DECL void bsf_component_ai_move(ecs_world_t* world, ecs_entity_t comp, const ecs_entity_t* dst_ent, const ecs_entity_t* src_ent, 
+        void* dst_ptr, void* src_ptr, size_t sz, int32_t count, void* ctx);
 
 typedef struct
 {
     bsf_component_gun_t* gc;
     bsf_component_transform_t* tc;
-    bsf_component_physics_t* pc;
+    bsf_component_velocity_t* vc;
     bsf_component_health_t* hc;
     bsf_component_transform_t* ptc; // Player transform component
     bsf_component_ai_t* ac;
@@ -436,7 +725,8 @@ GS_API_DECL void bsf_ai_task_move_to_target_location(struct gs_ai_bt_t* bt, stru
 ECS_COMPONENT_DECLARE(bsf_component_renderable_t);
 ECS_COMPONENT_DECLARE(bsf_component_renderable_immediate_t);
 ECS_COMPONENT_DECLARE(bsf_component_transform_t);
-ECS_COMPONENT_DECLARE(bsf_component_physics_t);
+ECS_COMPONENT_DECLARE(bsf_component_velocity_t);
+ECS_COMPONENT_DECLARE(bsf_component_collider_t);
 ECS_COMPONENT_DECLARE(bsf_component_projectile_t);
 ECS_COMPONENT_DECLARE(bsf_component_character_stats_t);
 ECS_COMPONENT_DECLARE(bsf_component_timer_t);
@@ -456,10 +746,89 @@ ECS_COMPONENT_DECLARE(bsf_component_item_t);
 //=== BSF Entities ===// 
 
 GS_API_DECL void bsf_entities_init(struct bsf_t* bsf);
+GS_API_DECL void bsf_entities_reset(struct bsf_t* bsf);
+GS_API_DECL ecs_snapshot_t* bsf_entities_snapshot_take(struct bsf_t* bsf, size_t* size, uint32_t* count);
+GS_API_DECL void bsf_entities_snapshot_restore(struct bsf_t* bsf, ecs_snapshot_t* snapshot);
+
+//=== BSF Rest ===//
+
+#define BSF_REST_STATS_INTERVAL     1.f     // Seconds between stat samples
+
+// Run state, set as singleton for the flecs REST api (enabled with --rest [port])
+typedef struct
+{
+    int32_t entities;
+    int32_t tables;
+    int32_t systems;
+    float fps;
+    float frame_time;       // ms spent in ecs_progress per frame
+    int32_t level;
+    int32_t room_cell;
+    int32_t room_type;
+    int32_t room_mobs;
+    const char* seed;       // Points into bsf->run.seed
+} bsf_component_rest_stats_t;
+
+// Set on each system entity
+typedef struct
+{
+    float time;             // Average ms per invocation over last sample
+    int32_t invoke_count;   // Invocations over last sample
+    int32_t matched_entities;
+    int32_t active;
+} bsf_component_rest_system_stats_t;
+
+ECS_COMPONENT_DECLARE(bsf_component_rest_stats_t);
+ECS_COMPONENT_DECLARE(bsf_component_rest_system_stats_t);
+
+GS_API_DECL void bsf_rest_init(struct bsf_t* bsf);
+GS_API_DECL void bsf_rest_update(struct bsf_t* bsf);
+
+//=== BSF Capture ===//
+
+// Command stream capture for renderer benchmarks (enabled with --capture <path> [frames]), replayed by tools/cmd_replay.py
+#define BSF_CAPTURE_MAGIC           0x43465342      // "BSFC"
+#define BSF_CAPTURE_VERSION         2
+#define BSF_CAPTURE_DEFAULT_FRAMES  600
+
+// File header, frame count is patched in when capture ends. Followed by op_count opcodes then bind_count bind types.
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t frames;
+    uint32_t size_t_size;           // Width of size_t fields inside the command streams
+    uint32_t op_count;
+    uint32_t bind_count;
+} bsf_capture_header_t;
+
+// Name and value of a backend opcode or bind type, so replay decodes by name and notices when gs renumbers or adds any
+typedef struct
+{
+    char name[32];
+    uint32_t value;
+} bsf_capture_code_t;
+
+// Before each frame, followed by stream_count x (uint32 num_commands, uint32 size, size bytes of commands)
+typedef struct
+{
+    uint32_t frame;
+    float encode_ms;
+    uint32_t draws;                 // Renderer's own counts, replay cross checks its decode against these
+    uint32_t instances;
+    uint32_t pipeline_binds;
+    uint32_t mesh_binds;
+    uint32_t stream_count;
+} bsf_capture_frame_t;
+
+GS_API_DECL void bsf_capture_begin(struct bsf_t* bsf);
+GS_API_DECL void bsf_capture_frame(struct bsf_t* bsf, const bsf_render_frame_t* frame);   // Before frame's buffers are submitted
+GS_API_DECL void bsf_capture_end(struct bsf_t* bsf);
 
 GS_API_DECL void bsf_projectile_create(struct bsf_t* bsf, ecs_world_t* world,
         bsf_projectile_type type, bsf_owner_type owner, const gs_vqs* xform, gs_vec3 velocity);  // Create single projectile
 GS_API_DECL void bsf_projectile_system(ecs_iter_t* it);                                          // System for updating projectiles
+GS_API_DECL void bsf_projectile_hit_system(ecs_iter_t* it);                                      // System for projectile collisions
 
 /*
     Base Stats:
@@ -480,7 +849,8 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it);
 enum 
 {
     BSF_MOVEMENT_FREE_RANGE = 0x00,
-    BSF_MOVEMENT_RAIL
+    BSF_MOVEMENT_RAIL,
+    BSF_MOVEMENT_COUNT
 };
 
 GS_API_DECL void bsf_player_init(struct bsf_t* bsf);
@@ -511,6 +881,7 @@ typedef enum {
 //=== BSF Menus ===//
 
 GS_API_DECL void bsf_menu_update(struct bsf_t* bsf);
+GS_API_DECL void bsf_loading_update(struct bsf_t* bsf);     // Progress of streamed assets, while a state waits on them
 
 //=== BSF Editor ===//
 
@@ -525,8 +896,44 @@ GS_API_DECL void bsf_game_end(struct bsf_t* bsf);
 GS_API_DECL void bsf_game_update(struct bsf_t* bsf);
 
 //=== BSF Audio ===//
-GS_API_DECL void bsf_play_sound(struct bsf_t* bsf, const char* key, float volume);
-GS_API_DECL void bsf_play_music(struct bsf_t* bsf, const char* key);
+
+#define BSF_MUSIC_VOLUME        0.7f
+#define BSF_MUSIC_FADE          1.f         // Crossfade between tracks in seconds
+#define BSF_MUSIC_RING_FRAMES   16384       // ~0.35s at 48k, decoded ahead of the device
+#define BSF_MUSIC_CHUNK_FRAMES  1024
+#define BSF_MUSIC_CHANNELS      2
+
+// Music is streamed from file, only the path is loaded up front
+typedef struct
+{
+    char path[256];
+} bsf_music_track_t;
+
+// Music plays on its own device, decoded incrementally into a ring buffer the device callback drains
+typedef struct
+{
+    ma_device device;
+    ma_pcm_rb ring;
+    ma_decoder decoders[2];                 // Current track, and incoming track while crossfading
+    bool32 open[2];
+    uint32_t current;
+    uint32_t fade;                          // Frames into crossfade, fade_frames once done
+    uint32_t fade_frames;
+    ma_mutex lock;                          // Guards pending
+    const bsf_music_track_t* pending;       // Set by bsf_play_music, picked up by the decoder
+    float mix[BSF_MUSIC_CHUNK_FRAMES * BSF_MUSIC_CHANNELS * 2];
+    bool32 running;
+#ifdef BSF_JOB_THREADS
+    pthread_t thread;
+    bool32 quit;                            // Atomic, polled by the decoder thread
+#endif
+} bsf_music_t;
+
+GS_API_DECL void bsf_play_sound(struct bsf_t* bsf, const gs_asset_audio_t* src, float volume);
+GS_API_DECL void bsf_play_music(struct bsf_t* bsf, const bsf_music_track_t* track);
+GS_API_DECL void bsf_music_init(bsf_music_t* music);
+GS_API_DECL void bsf_music_update(bsf_music_t* music);        // Fills ring buffer, from main loop when there's no decoder thread
+GS_API_DECL void bsf_music_free(bsf_music_t* music);
 
 //=== BSF Test ===//
 
@@ -555,12 +962,30 @@ typedef struct
     gs_dyn_array(ecs_entity_t) obstacles;    // Mobs for this room
     gs_dyn_array(ecs_entity_t) consumables;    // Consumable for this room
     gs_dyn_array(ecs_entity_t) items;    // Consumable for this room
+    ecs_entity_t root;                   // Parent entity for everything spawned in this room (ChildOf)
     b32 cleared;                          // Whether or not this room is clear
     int16_t movement_type;
     int16_t cell;
 } bsf_room_t; 
 
+// State captured on room entry, used to retry the room
+typedef struct
+{
+    ecs_snapshot_t* world;                      // Entity world at time of room entry
+    bsf_room_t room;                            // Room state (entity lists are copied)
+    gs_dyn_array(bsf_item_type) item_pool;
+    gs_mt_rand_t rand;
+    ecs_entity_t boss;
+    size_t size;                                // Component data held by world snapshot (bytes)
+    uint32_t count;                             // Entities held by world snapshot
+} bsf_room_snapshot_t;
+
 GS_API_DECL void bsf_room_load(struct bsf_t* bsf, uint32_t cell);
+GS_API_DECL void bsf_room_unload(struct bsf_t* bsf, bsf_room_t* room);
+GS_API_DECL void bsf_room_add_entity(struct bsf_t* bsf, bsf_room_t* room, ecs_entity_t e);
+GS_API_DECL void bsf_room_snapshot_take(struct bsf_t* bsf);
+GS_API_DECL void bsf_room_snapshot_restore(struct bsf_t* bsf);
+GS_API_DECL void bsf_room_snapshot_free(struct bsf_t* bsf);
 
 //=== BSF Room Template ===//
 
@@ -596,21 +1021,425 @@ typedef struct
     gs_gfxt_material_t* material;
 } bsf_model_t; 
 
+// Assets used at runtime: X(table, type, name, key)
+#define BSF_ASSET_HANDLES(X)\
+    X(materials, gs_gfxt_material_t, mat_simple, "mat.simple")                            \
+    X(materials, gs_gfxt_material_t, mat_color, "mat.color")                              \
+    X(materials, gs_gfxt_material_t, mat_gsi, "mat.gsi")                                  \
+    X(materials, gs_gfxt_material_t, mat_gui, "mat.gui")                                  \
+    X(materials, gs_gfxt_material_t, mat_skybox, "mat.skybox")                            \
+    X(materials, gs_gfxt_material_t, mat_world, "mat.world")                              \
+    X(materials, gs_gfxt_material_t, mat_ship_arwing, "mat.ship_arwing")                  \
+    X(materials, gs_gfxt_material_t, mat_slave, "mat.slave")                              \
+    X(materials, gs_gfxt_material_t, mat_bandit, "mat.bandit")                            \
+    X(materials, gs_gfxt_material_t, mat_turret, "mat.turret")                            \
+    X(materials, gs_gfxt_material_t, mat_laser, "mat.laser")                              \
+    X(materials, gs_gfxt_material_t, mat_sky_sphere, "mat.sky_sphere")                    \
+    X(materials, gs_gfxt_material_t, mat_brain, "mat.brain")                              \
+    X(meshes, gs_gfxt_mesh_t, mesh_ship, "mesh.ship")                                     \
+    X(meshes, gs_gfxt_mesh_t, mesh_slave, "mesh.slave")                                   \
+    X(meshes, gs_gfxt_mesh_t, mesh_arwing, "mesh.arwing")                                 \
+    X(meshes, gs_gfxt_mesh_t, mesh_arwing64, "mesh.arwing64")                             \
+    X(meshes, gs_gfxt_mesh_t, mesh_bandit, "mesh.bandit")                                 \
+    X(meshes, gs_gfxt_mesh_t, mesh_turret, "mesh.turret")                                 \
+    X(meshes, gs_gfxt_mesh_t, mesh_laser_player, "mesh.laser_player")                     \
+    X(meshes, gs_gfxt_mesh_t, mesh_brain, "mesh.brain")                                   \
+    X(textures, gs_gfxt_texture_t, tex_default, "tex.default")                            \
+    X(textures, gs_gfxt_texture_t, tex_slave, "tex.slave")                                \
+    X(textures, gs_gfxt_texture_t, tex_arwing, "tex.arwing")                              \
+    X(textures, gs_gfxt_texture_t, tex_vignette, "tex.vignette")                          \
+    X(textures, gs_gfxt_texture_t, tex_title_bg, "tex.title_bg")                          \
+    X(textures, gs_gfxt_texture_t, tex_icon_inner_eye, "tex.icon_inner_eye")              \
+    X(textures, gs_gfxt_texture_t, tex_icon_polyphemus, "tex.icon_polyphemus")            \
+    X(textures, gs_gfxt_texture_t, tex_icon_spoon_bender, "tex.icon_spoon_bender")        \
+    X(textures, gs_gfxt_texture_t, tex_icon_sad_onion, "tex.icon_sad_onion")              \
+    X(textures, gs_gfxt_texture_t, tex_icon_magic_mushroom, "tex.icon_magic_mushroom")    \
+    X(cubemaps, gs_gfxt_texture_t, cmap_skybox, "cmap.skybox")                            \
+    X(models, bsf_model_t, models_skybox, "models.skybox")                                \
+    X(style_sheets, gs_gui_style_sheet_t, ss_title, "ss.title")                           \
+    X(sounds, gs_asset_audio_t, audio_laser, "audio.laser")                               \
+    X(sounds, gs_asset_audio_t, audio_laser2, "audio.laser2")                             \
+    X(sounds, gs_asset_audio_t, audio_bang, "audio.bang")                                 \
+    X(sounds, gs_asset_audio_t, audio_explosion, "audio.explosion")                       \
+    X(sounds, gs_asset_audio_t, audio_explosion_boss, "audio.explosion_boss")             \
+    X(sounds, gs_asset_audio_t, audio_health_pickup, "audio.health_pickup")               \
+    X(sounds, gs_asset_audio_t, audio_bomb_pickup, "audio.bomb_pickup")                   \
+    X(sounds, gs_asset_audio_t, audio_menu_select, "audio.menu_select")                   \
+    X(sounds, gs_asset_audio_t, audio_start, "audio.start")                               \
+    X(sounds, gs_asset_audio_t, audio_pause, "audio.pause")                               \
+    X(sounds, gs_asset_audio_t, audio_arwing_hit, "audio.arwing_hit")                     \
+    X(sounds, gs_asset_audio_t, audio_hit_no_damage, "audio.hit_no_damage")               \
+    X(music, bsf_music_track_t, music_boss, "music.boss")                                 \
+    X(music, bsf_music_track_t, music_title, "music.title")                               \
+    X(music, bsf_music_track_t, music_level, "music.level")                               \
+    X(music, bsf_music_track_t, music_level_complete, "music.level_complete")
+
+typedef struct
+{
+    #define X(TABLE, T, NAME, KEY) T* NAME;
+    BSF_ASSET_HANDLES(X)
+    #undef X
+} bsf_asset_handles_t;
+
+#define BSF_UNIFORM_SLOT_INVALID    UINT32_MAX
+
+// Indices into a pipeline's uniform block for the uniforms set every frame
+typedef struct
+{
+    const gs_gfxt_pipeline_t* pip;
+    uint32_t u_mvp;
+    uint32_t u_model;
+    uint32_t u_tex;
+    uint32_t u_color;
+    uint32_t u_scroll;
+} bsf_uniform_slots_t;
+
+// Baked asset pack (tools/asset_pack.py), everything in it is ready to upload as is
+#define BSF_ASSET_PACK_MAGIC        0x50465342      // "BSFP"
+#define BSF_ASSET_PACK_VERSION      2
+#define BSF_ASSET_PACK_PATH_MAX     112
+
+typedef enum
+{
+    BSF_ASSET_PACK_IMAGE = 0x01,        // width * height * comps bytes
+    BSF_ASSET_PACK_MESH,                // bsf_asset_pack_mesh_t, primitives, vertex and index data
+    BSF_ASSET_PACK_FONT                 // Baked atlas as in the font cache (bsf_font_cache_header_t on), one per size of the ttf in path
+} bsf_asset_pack_type;
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;                     // Entries following the header
+    uint32_t reserved;
+} bsf_asset_pack_header_t;
+
+typedef struct
+{
+    char path[BSF_ASSET_PACK_PATH_MAX]; // Relative to asset dir, as in the asset tables
+    uint32_t type;
+    uint32_t width;
+    uint32_t height;
+    uint32_t comps;                     // Point size for fonts
+    uint64_t offset;                    // From start of pack, 16 byte aligned
+    uint64_t size;
+    uint64_t source_size;               // Loose file baked from (meshes add <mesh>.bin), entry is stale once either differs
+    uint64_t source_mtime;
+} bsf_asset_pack_entry_t;
+
+typedef struct
+{
+    float bounds[4];                    // Local bounding sphere
+    char layout[48];                    // Mesh layout baked for, ie. "POSITION,NORMAL,TEXCOORD,COLOR"
+    uint32_t index_size;
+    uint32_t primitive_count;
+    uint32_t pad[2];
+} bsf_asset_pack_mesh_t;
+
+typedef struct
+{
+    uint64_t vertex_offset;             // From start of mesh entry
+    uint64_t vertex_size;
+    uint64_t index_offset;
+    uint64_t index_size;
+    uint32_t count;
+    uint32_t pad[3];
+} bsf_asset_pack_primitive_t;
+
+typedef struct
+{
+    const uint8_t* data;
+    size_t size;
+    const bsf_asset_pack_entry_t* entries;
+    uint32_t count;
+    bool32 mapped;
+    char dir[256];                      // Loose files the entries were baked from
+} bsf_asset_pack_t;
+
+GS_API_DECL bool32 bsf_asset_pack_open(bsf_asset_pack_t* pack, const char* path);
+GS_API_DECL const bsf_asset_pack_entry_t* bsf_asset_pack_find(const bsf_asset_pack_t* pack, const char* path, bsf_asset_pack_type type);
+GS_API_DECL const bsf_asset_pack_entry_t* bsf_asset_pack_find_font(const bsf_asset_pack_t* pack, const char* path, uint32_t pt);
+GS_API_DECL void bsf_asset_pack_close(bsf_asset_pack_t* pack);
+
+// Font atlas cache (fonts/<font>.<pt>.bsff), written on first launch and reused while the ttf is unchanged
+#define BSF_FONT_CACHE_MAGIC        0x46465342      // "BSFF"
+#define BSF_FONT_CACHE_VERSION      1
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t hash;                      // Of the ttf
+    uint32_t point_size;
+    uint32_t font_size;                 // sizeof(gs_asset_font_t), a gs update invalidates the cache
+    uint32_t width;
+    uint32_t height;
+} bsf_font_cache_header_t;              // Followed by glyphs, metrics after the texture in gs_asset_font_t, coverage (width * height)
+
+// Pipeline cache (pipelines/<pipeline>.sf.bsfp), skips the .sf parse on warm starts and the shader compile too
+// where the driver hands out program binaries. Stale once the .sf, the driver or gs changes.
+#define BSF_PIPELINE_CACHE_MAGIC    0x50465342      // "BSFP"
+#define BSF_PIPELINE_CACHE_VERSION  1
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t hash;                      // Of the .sf, seeded with the driver's vendor, renderer and version
+    uint32_t desc_size;                 // sizeof(gs_graphics_pipeline_desc_t), a gs update invalidates the cache
+    uint32_t attr_count;
+    uint32_t mesh_layout_count;
+    uint32_t uniform_count;
+    uint32_t source_count;
+    uint32_t binary_format;
+    uint32_t binary_size;               // 0 where the driver reports no binary formats
+    uint32_t pad;
+} bsf_pipeline_cache_header_t;          // Followed by desc, attrs, mesh layout, uniforms, sources, program binary
+
+typedef struct
+{
+    char name[64];
+    uint32_t type;                      // gs_graphics_uniform_type
+    uint32_t binding;
+} bsf_pipeline_cache_uniform_t;
+
+typedef struct
+{
+    uint32_t stage;                     // gs_graphics_shader_stage_type
+    uint32_t size;                      // Of the glsl following, terminator included
+} bsf_pipeline_cache_source_t;
+
+// Linked program read back from the gl backend, glsl and binary owned until bsf_gl_program_free
+typedef struct
+{
+    gs_graphics_shader_source_desc_t sources[GS_GRAPHICS_SHADER_STAGE_COUNT];
+    uint32_t source_count;
+    void* binary;
+    uint32_t binary_size;               // 0 where the driver reports no binary formats
+    uint32_t binary_format;
+} bsf_gl_program_t;
+
+#define BSF_ASSET_STREAM_BUDGET     4.f         // Ms per frame spent creating streamed resources
+#define BSF_TEXTURE_MIPS_FULL       UINT32_MAX  // As num_mips in the texture table, full chain once the size is known
+
+// Decoded on the job pool, uploaded on main thread
+typedef struct
+{
+    char path[256];
+    uint32_t width;
+    uint32_t height;
+    uint32_t num_comps;
+    void* data;
+    bool32 packed;          // Points into the asset pack, nothing to decode or free
+    bool32 ready;           // Set by the decode job
+} bsf_asset_image_t;
+
+#define BSF_FONT_ATLAS_SIZE         512         // Same atlas gs_asset_font_load_from_memory bakes into
+
+// Rasterized (or read from the pack or its atlas cache) on the job pool, atlas texture created on main thread
+typedef struct
+{
+    char cache[256];
+    const uint8_t* packed;  // Baked atlas in the asset pack, NULL if not packed
+    size_t packed_size;
+    const char* ttf;        // Shared by every size of the ttf
+    uint64_t hash;          // Of the ttf
+    uint32_t pt;
+    gs_asset_font_t font;   // Glyphs and metrics, texture is created when it lands
+    uint8_t* coverage;      // Of the atlas, NULL if the ttf couldn't be baked
+    uint32_t width;
+    uint32_t height;
+    bool32 cached;          // From the pack or the atlas cache
+    bool32 ready;           // Set by the bake job
+} bsf_asset_font_t;
+
+typedef enum
+{
+    BSF_ASSET_LOAD_TEXTURE = 0x00,
+    BSF_ASSET_LOAD_CUBEMAP,
+    BSF_ASSET_LOAD_MESH,
+    BSF_ASSET_LOAD_SOUND
+} bsf_asset_load_type;
+
+// Left in flight by bsf_assets_init, its table entry holds a placeholder until the load lands
+typedef struct
+{
+    bsf_asset_load_type type;
+    uint64_t key;                               // Into the table of its type, entry is overwritten in place so resolved handles never change
+    char path[256];
+    gs_graphics_texture_desc_t desc;            // Textures and cubemaps
+    uint32_t images[6];                         // Decodes of texture (first only) or cubemap faces
+    const gs_gfxt_pipeline_t* pip;              // Mesh layout
+    gs_vec4 bounds;                             // Mesh bounds, computed on the job pool unless packed
+    bool32 ready;                               // Bounds are in
+    bool32 done;
+} bsf_asset_load_t;
+
+typedef struct
+{
+    gs_dyn_array(bsf_asset_load_t) loads;
+    bsf_asset_image_t* images;
+    uint32_t image_count;
+    uint32_t done;                              // Loads landed, progress is done / loads
+    uint32_t jobs;                              // Decode jobs pushed
+    gs_hash_table(uint64_t, gs_gfxt_mesh_t) placeholders;   // Per mesh pipeline, keyed by pipeline pointer
+    float t0;
+} bsf_asset_stream_t;
+
+typedef enum
+{
+    BSF_ASSET_WATCH_PIPELINE = 0x00,
+    BSF_ASSET_WATCH_TEXTURE,
+    BSF_ASSET_WATCH_MESH,
+    BSF_ASSET_WATCH_ROOM_TEMPLATE,
+    BSF_ASSET_WATCH_STYLE_SHEET
+} bsf_asset_watch_type;
+
+// File behind a table entry, reloaded into the entry when it changes so resolved handles never change
+typedef struct
+{
+    bsf_asset_watch_type type;
+    uint64_t key;                               // Into the table of its type
+    char path[256];                             // Relative to the asset dir
+    gs_graphics_texture_desc_t desc;            // Textures
+    const gs_gfxt_pipeline_t* pip;              // Mesh layout
+    bool32 dirty;
+} bsf_asset_watch_t;
+
+// Replaced by a reload, destroyed once no frame in flight can reference it
+typedef struct
+{
+    bsf_asset_watch_type type;
+    gs_gfxt_texture_t texture;
+    gs_gfxt_mesh_t mesh;
+    gs_gfxt_pipeline_t pipeline;
+    uint32_t frames;
+} bsf_asset_retired_t;
+
+typedef struct
+{
+    gs_dyn_array(bsf_asset_watch_t) watches;
+    gs_dyn_array(bsf_asset_retired_t) retired;
+    int32_t fd;                                 // inotify, -1 without
+    int32_t wds[8];
+    const char* dirs[8];                        // Watched subdir of each wd
+    uint32_t dir_count;
+} bsf_asset_reload_t;
+
 typedef struct {
     const char* asset_dir;
+    bsf_asset_pack_t pack;                                          // Only open while streaming
+    bsf_asset_stream_t stream;
+    bsf_asset_reload_t reload;
     gs_hash_table(uint64_t, gs_gfxt_pipeline_t)   pipelines;
     gs_hash_table(uint64_t, gs_gfxt_texture_t)    textures;
     gs_hash_table(uint64_t, gs_gfxt_material_t)   materials;
     gs_hash_table(uint64_t, gs_gfxt_mesh_t)       meshes;
+    gs_hash_table(uint64_t, gs_vec4)              mesh_bounds;      // Local bounding sphere, keyed by mesh pointer
+    gs_hash_table(uint64_t, bsf_mesh_lod_t)       mesh_lods;        // Detail levels, keyed by source mesh pointer
     gs_hash_table(uint64_t, gs_asset_font_t)      fonts;
     gs_hash_table(uint64_t, gs_gui_style_sheet_t) style_sheets;
     gs_hash_table(uint64_t, gs_gfxt_texture_t)    cubemaps;
     gs_hash_table(uint64_t, bsf_model_t)          models;
     gs_hash_table(uint64_t, bsf_room_template_t)  room_templates;
     gs_hash_table(uint64_t, gs_asset_audio_t)     sounds;
+    gs_hash_table(uint64_t, bsf_music_track_t)    music;
+    bsf_asset_handles_t                           hndl;             // Resolved once at load, use these over keyed lookups at runtime
+    gs_dyn_array(bsf_uniform_slots_t)             uniform_slots;
+    gs_dyn_array(const gs_gfxt_pipeline_t*)       uniform_slot_pips; // Pipeline of each uniform_slots entry, packed for the lookup scan
 } bsf_assets_t;
 
-GS_API_DECL void bsf_assets_init(struct bsf_t* bsf, bsf_assets_t* assets);
+GS_API_DECL void bsf_assets_init(struct bsf_t* bsf, bsf_assets_t* assets);       // Returns once the title screen can draw
+GS_API_DECL void bsf_assets_stream(bsf_assets_t* assets);                          // Lands finished loads, on the thread owning the gpu context
+GS_API_DECL void bsf_assets_stream_free(bsf_assets_t* assets);                     // Decode jobs must be finished
+GS_API_DECL void bsf_assets_reload(struct bsf_t* bsf);                             // Reloads changed files in place, on the thread owning the gpu context
+GS_API_DECL void bsf_assets_reload_free(bsf_assets_t* assets);
+GS_API_DECL bool32 bsf_assets_loaded(const bsf_assets_t* assets);
+GS_API_DECL float bsf_assets_progress(const bsf_assets_t* assets);
+GS_API_DECL const bsf_uniform_slots_t* bsf_assets_uniform_slots(const bsf_assets_t* assets, const gs_gfxt_material_t* mat);
+GS_API_DECL void bsf_material_set_uniform_slot(gs_gfxt_material_t* mat, uint32_t slot, const void* data);
+
+#define BSF_MATERIAL_SET_UNIFORM(ASSETS, MAT, NAME, DATA)\
+    bsf_material_set_uniform_slot((MAT), bsf_assets_uniform_slots((ASSETS), (MAT))->NAME, (DATA))
+
+//=== BSF World ===//
+
+// Ground and backdrop, baked once per movement type
+enum
+{
+    BSF_WORLD_LAYER_STATIC = 0x00,
+    BSF_WORLD_LAYER_SCROLL,         // Offset along z by u_scroll
+    BSF_WORLD_LAYER_COUNT
+};
+
+typedef struct
+{
+    gs_vec3 position;
+    gs_color_t color;
+} bsf_world_vert_t;
+
+typedef struct
+{
+    bsf_model_t layers[BSF_WORLD_LAYER_COUNT];
+    uint32_t counts[BSF_WORLD_LAYER_COUNT];     // Index count per layer
+    bool32 baked;
+} bsf_world_geometry_t;
+
+GS_API_DECL void bsf_world_bake(struct bsf_t* bsf, int16_t movement_type);
+GS_API_DECL void bsf_world_draw(struct bsf_t* bsf, gs_command_buffer_t* cb, gs_gfxt_material_t* mat, int16_t movement_type, gs_vec3 scroll);   // Baked beforehand
+GS_API_DECL void bsf_world_free(struct bsf_t* bsf);
+
+//=== BSF Particles ===//
+
+#define BSF_PARTICLE_MAX    4096        // Pool capacity, multiple of 4
+
+typedef enum
+{
+    BSF_PARTICLE_EXPLOSION = 0x00,
+    BSF_PARTICLE_IMPACT,
+    BSF_PARTICLE_BOSS_DEATH,
+    BSF_PARTICLE_TRAIL,
+    BSF_PARTICLE_EFFECT_COUNT
+} bsf_particle_effect;
+
+// Spawn parameters of an effect, ranges are picked uniformly in [min, max]
+typedef struct
+{
+    uint32_t count;
+    float speed[2];
+    float life[2];
+    float size[2];
+    float gravity;
+    float drag;                 // Fraction of velocity lost per second
+    float color_start[4];
+    float color_end[4];
+} bsf_particle_emitter_t;
+
+// Fixed capacity SoA pool, live particles are packed at the front and integrated 4 at a time
+typedef struct
+{
+    float* px;
+    float* py;
+    float* pz;
+    float* vx;
+    float* vy;
+    float* vz;
+    float* gravity;
+    float* drag;
+    float* life;                // Seconds left
+    float* inv_life;            // 1 / lifetime, for normalized age
+    float* size;
+    uint8_t* effect;            // Colors come from the effect's emitter
+    uint32_t count;
+    gs_mt_rand_t rand;          // Own generator so effects don't advance the run's
+} bsf_particles_t;
+
+GS_API_DECL void bsf_particles_init(bsf_particles_t* ps);
+GS_API_DECL void bsf_particles_emit(bsf_particles_t* ps, bsf_particle_effect effect, gs_vec3 position, float scale);
+GS_API_DECL void bsf_particles_update(bsf_particles_t* ps, float dt);
+GS_API_DECL void bsf_particles_extract(const bsf_particles_t* ps, gs_dyn_array(bsf_render_instance_t)* instances);
+GS_API_DECL void bsf_particles_clear(bsf_particles_t* ps);
+GS_API_DECL void bsf_particles_free(bsf_particles_t* ps);
 
 //=== BSF App ===// 
 
@@ -624,6 +1453,9 @@ typedef struct bsf_t
 
     bsf_assets_t assets;        // Asset manager 
 	bsf_graphics_scene_t scene; // Should the scene hold onto the active camera?  
+    bsf_world_geometry_t world[BSF_MOVEMENT_COUNT];
+    bsf_particles_t particles;
+    bsf_jobs_t jobs;
     bsf_state state;            // Current state of application
 
     struct {
@@ -642,18 +1474,37 @@ typedef struct bsf_t
         b32 complete;
         float clear_timer;
         gs_dyn_array(bsf_item_type) item_pool;
+        bsf_room_snapshot_t snapshot;    // Snapshot of current room at entry
     } run;
 
     struct {
         ecs_entity_t player;    // Main player
         ecs_entity_t boss;      // Boss
         ecs_world_t* world;     // Main flecs entity world
+        ecs_snapshot_t* base;   // Empty world after registration, restored to reset between runs
+        bool32 snapshotting;    // Set while taking a snapshot so copy hooks give the copy its own resources
     } entities;
 
+    struct {
+        bool32 enabled;                 // Set by --rest command line option
+        uint16_t port;                  // 0 for flecs default (27750)
+        float timer;                    // Time since last stats sample
+        ecs_entity_t dequeue;           // flecs REST dequeue system, ran manually when world isn't progressing
+        ecs_world_stats_t world;
+        ecs_pipeline_stats_t pipeline;
+    } rest;
+
+    struct {
+        const char* path;               // Set by --capture command line option
+        uint32_t frames;                // Play frames to record before quitting
+        uint32_t frame;
+        FILE* fp;
+    } capture;
+
     int16_t dbg;
 
-    // Music audio handle
-    gs_handle(gs_audio_instance_t) music;
+    // Streamed music
+    bsf_music_t music;
 
 } bsf_t; 
 
@@ -672,11 +1523,28 @@ void bsf_init()
     bsf->state = BSF_STATE_TITLE;
 
     // Initialize all asset data
+    bsf_jobs_init(&bsf->jobs);
     bsf_assets_init(bsf, &bsf->assets);
 
+    bsf->scene.camera_ubo = gs_graphics_uniform_buffer_create(&(gs_graphics_uniform_buffer_desc_t){
+        .data = NULL,
+        .size = sizeof(bsf_camera_uniforms_t),
+        .name = "u_camera",
+        .usage = GS_GRAPHICS_BUFFER_USAGE_DYNAMIC
+    });
+    bsf_graphics_shapes_create(&bsf->scene);
+    bsf_graphics_frames_init(&bsf->scene);
+    bsf_particles_init(&bsf->particles);
+    bsf_capture_begin(bsf);
+
+    // Bring entity world up early so REST is available from the title screen
+    if (bsf->rest.enabled) {
+        bsf_entities_init(bsf);
+    }
+
     // Start playing title music
-    bsf->music.id = UINT32_MAX;
-    bsf_play_music(bsf, "audio.music_title");
+    bsf_music_init(&bsf->music);
+    bsf_play_music(bsf, bsf->assets.hndl.music_title);
 }
 
 void bsf_update()
@@ -704,8 +1572,10 @@ void bsf_update()
 
         case BSF_STATE_START:
         {
+            // Runs use everything streamed in, wait on a loading bar until it all lands
             gs_platform_lock_mouse(gs_platform_main_window(), false);
-            bsf_game_start(bsf);
+            if (!bsf_assets_loaded(&bsf->assets)) bsf_loading_update(bsf);
+            else                                  bsf_game_start(bsf);
         } break;
 
         case BSF_STATE_PLAY:
@@ -722,7 +1592,8 @@ void bsf_update()
         case BSF_STATE_EDITOR_START:
         {
             gs_platform_lock_mouse(gs_platform_main_window(), false);
-            bsf_editor_start(bsf);
+            if (!bsf_assets_loaded(&bsf->assets)) bsf_loading_update(bsf);
+            else                                  bsf_editor_start(bsf);
         } break; 
 
         case BSF_STATE_EDITOR:
@@ -734,7 +1605,7 @@ void bsf_update()
         {
             // Just end the game for now...
             bsf_game_end(bsf);
-            bsf_play_music(bsf, "audio.music_title");
+            bsf_play_music(bsf, bsf->assets.hndl.music_title);
         } break;
 
         case BSF_STATE_QUIT:
@@ -749,6 +1620,9 @@ void bsf_update()
         } break;
     } 
 
+    bsf_rest_update(bsf);
+    bsf_music_update(&bsf->music);
+
     gs_gui_end(&bsf->gs.gui);
 
     bsf_graphics_render(bsf);
@@ -757,6 +1631,30 @@ void bsf_update()
 void bsf_shutdown()
 {
     bsf_t* bsf = gs_user_data(bsf_t);
+
+    // Workers may still be decoding into the asset stream
+    bsf_jobs_free(&bsf->jobs);
+    bsf_assets_stream_free(&bsf->assets);
+
+    if (bsf->entities.world) {
+        bsf_room_snapshot_free(bsf);
+        ecs_snapshot_free(bsf->entities.base);
+        ecs_pipeline_stats_fini(&bsf->rest.pipeline);
+        ecs_fini(bsf->entities.world);
+    }
+    bsf_graphics_frames_free(&bsf->scene);
+    bsf_particles_free(&bsf->particles);
+    bsf_capture_end(bsf);
+    bsf_music_free(&bsf->music);
+    bsf_assets_reload_free(&bsf->assets);
+    bsf_render_queue_free(&bsf->scene.queue);
+    bsf_render_instancing_free(&bsf->scene.instancing);
+    bsf_render_cull_free(&bsf->scene.cull);
+    bsf_world_free(bsf);
+    gs_graphics_uniform_buffer_destroy(bsf->scene.camera_ubo);
+    bsf_graphics_shapes_free(&bsf->scene);
+    gs_dyn_array_free(bsf->scene.immediates);
+    gs_dyn_array_free(bsf->scene.immediate_items);
     gs_immediate_draw_free(&bsf->gs.gsi);
     gs_command_buffer_free(&bsf->gs.cb);
     gs_gui_free(&bsf->gs.gui);
@@ -764,8 +1662,33 @@ void bsf_shutdown()
 
 gs_app_desc_t gs_main(int32_t argc, char** argv)
 {
+    bsf_t* bsf = gs_malloc_init(bsf_t);
+
+    // Command line options
+    for (int32_t i = 1; i < argc; ++i)
+    {
+        // --rest [port]: serve flecs REST api on localhost (explorer at https://flecs.dev/explorer)
+        if (gs_string_compare_equal(argv[i], "--rest"))
+        {
+            bsf->rest.enabled = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                bsf->rest.port = (uint16_t)atoi(argv[++i]);
+            }
+        }
+
+        // --capture <path> [frames]: record scene and overlay command buffers of play frames, then quit
+        else if (gs_string_compare_equal(argv[i], "--capture") && i + 1 < argc)
+        {
+            bsf->capture.path = argv[++i];
+            bsf->capture.frames = BSF_CAPTURE_DEFAULT_FRAMES;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                bsf->capture.frames = (uint32_t)atoi(argv[++i]);
+            }
+        }
+    }
+
 	return (gs_app_desc_t) {
-        .user_data = gs_malloc_init(bsf_t),
+        .user_data = bsf,
 		.window_width = 1200,
 		.window_height = 700,
         .window_title = "Binding of Star Fox",
@@ -775,425 +1698,3135 @@ gs_app_desc_t gs_main(int32_t argc, char** argv)
 	};
 }
 
-//=== BSF Assets ===//
+//=== BSF Jobs ===//
 
-GS_API_DECL void bsf_assets_init(bsf_t* bsf, bsf_assets_t* assets)
+#ifdef BSF_JOB_THREADS
+static void* bsf_jobs_thread(void* data)
 {
-    assets->asset_dir = gs_platform_dir_exists("./assets") ? "./assets" : "../assets";
-
-    // Room templates
-    struct {const char* key; const char* path;} room_templates[] = {
-        {.key = "rt.r0", .path = "room_templates/r0.rt"},
-        {.key = "rt.r1", .path = "room_templates/r1.rt"},
-        {.key = "rt.r2", .path = "room_templates/r2.rt"},
-        {.key = "rt.r3", .path = "room_templates/r3.rt"},
-        {.key = "rt.r4", .path = "room_templates/r4.rt"},
-        {.key = "rt.r5", .path = "room_templates/r5.rt"},
-        {.key = "rt.r6", .path = "room_templates/r6.rt"},
-        {.key = "rt.r7", .path = "room_templates/r7.rt"},
-        {.key = "rt.r8", .path = "room_templates/r8.rt"},
-        {.key = "rt.r9", .path = "room_templates/r9.rt"},
-        {NULL}
-    };
-
-    for (uint32_t i = 0; room_templates[i].key; ++i)
+    bsf_jobs_t* jobs = (bsf_jobs_t*)data;
+    pthread_mutex_lock(&jobs->lock);
+    for (;;)
     {
-        bsf_room_template_t rt = {0};
-        memcpy(rt.path, room_templates[i].path, 256);
-
-        gs_snprintfc(TMP, 256, "%s/%s", assets->asset_dir, room_templates[i].path); 
-        if (gs_platform_file_exists(TMP))
-        {
-            gs_byte_buffer_t buffer = gs_byte_buffer_new();
-            gs_byte_buffer_read_from_file(&buffer, TMP); 
-            gs_byte_buffer_readc(&buffer, uint16_t, ct); 
-            for (uint32_t i = 0; i < ct; ++i)
-            {
-                gs_byte_buffer_readc(&buffer, bsf_room_brush_t, br);
-                gs_slot_array_insert(rt.brushes, br);
-            }
-            gs_byte_buffer_free(&buffer);
+        while (jobs->next == gs_dyn_array_size(jobs->queue) && !jobs->quit) {
+            pthread_cond_wait(&jobs->work, &jobs->lock);
         }
+        if (jobs->next == gs_dyn_array_size(jobs->queue)) break;
 
-        gs_hash_table_insert(assets->room_templates, gs_hash_str64(room_templates[i].key), rt);
+        // Copied out, queue may grow (and move) while the job runs
+        bsf_job_t job = jobs->queue[jobs->next++];
+        jobs->running++;
+        pthread_mutex_unlock(&jobs->lock);
+        job.func(job.data);
+        pthread_mutex_lock(&jobs->lock);
+
+        jobs->running--;
+        pthread_cond_broadcast(&jobs->done);
     }
+    pthread_mutex_unlock(&jobs->lock);
+    return NULL;
+}
+#endif
+
+GS_API_DECL void bsf_jobs_init(bsf_jobs_t* jobs)
+{
+    memset(jobs, 0, sizeof(bsf_jobs_t));
+#ifdef BSF_JOB_THREADS
+    // One core is left to the main thread
+    int32_t cores = 4;
+#ifdef _SC_NPROCESSORS_ONLN
+    cores = (int32_t)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    jobs->thread_count = (uint32_t)gs_clamp(cores - 1, 1, BSF_JOB_THREADS_MAX);
+    pthread_mutex_init(&jobs->lock, NULL);
+    pthread_cond_init(&jobs->work, NULL);
+    pthread_cond_init(&jobs->done, NULL);
+    for (uint32_t i = 0; i < jobs->thread_count; ++i) {
+        pthread_create(&jobs->threads[i], NULL, bsf_jobs_thread, jobs);
+    }
+#endif
+}
 
-    struct {const char* key; const char* path;} pipelines[] = {
-        {.key = "pip.simple", .path = "pipelines/simple.sf"},
-        {.key = "pip.hit", .path = "pipelines/hit.sf"},
-        {.key = "pip.color", .path = "pipelines/color.sf"},
-        {.key = "pip.gsi", .path = "pipelines/gsi.sf"},
-        {.key = "pip.skybox", .path = "pipelines/skybox.sf"},
+GS_API_DECL void bsf_jobs_push(bsf_jobs_t* jobs, bsf_job_func_t func, void* data)
+{
+#ifdef BSF_JOB_THREADS
+    pthread_mutex_lock(&jobs->lock);
+    gs_dyn_array_push(jobs->queue, ((bsf_job_t){.func = func, .data = data}));
+    pthread_cond_signal(&jobs->work);
+    pthread_mutex_unlock(&jobs->lock);
+#else
+    func(data);
+#endif
+}
+
+GS_API_DECL void bsf_jobs_wait(bsf_jobs_t* jobs)
+{
+#ifdef BSF_JOB_THREADS
+    pthread_mutex_lock(&jobs->lock);
+    while (jobs->next < gs_dyn_array_size(jobs->queue) || jobs->running) {
+        pthread_cond_wait(&jobs->done, &jobs->lock);
+    }
+    gs_dyn_array_clear(jobs->queue);
+    jobs->next = 0;
+    pthread_mutex_unlock(&jobs->lock);
+#endif
+}
+
+GS_API_DECL void bsf_jobs_free(bsf_jobs_t* jobs)
+{
+#ifdef BSF_JOB_THREADS
+    pthread_mutex_lock(&jobs->lock);
+    jobs->quit = true;
+    pthread_cond_broadcast(&jobs->work);
+    pthread_mutex_unlock(&jobs->lock);
+    for (uint32_t i = 0; i < jobs->thread_count; ++i) {
+        pthread_join(jobs->threads[i], NULL);
+    }
+    pthread_cond_destroy(&jobs->done);
+    pthread_cond_destroy(&jobs->work);
+    pthread_mutex_destroy(&jobs->lock);
+#endif
+    gs_dyn_array_free(jobs->queue);
+    memset(jobs, 0, sizeof(bsf_jobs_t));
+}
+
+//=== BSF Assets ===//
+
+static gs_vec4 bsf_graphics_mesh_bounds_from_file(const char* path)
+{
+    gs_vec3 mn = gs_v3s(FLT_MAX), mx = gs_v3s(-FLT_MAX);
+    cgltf_options options = {0};
+    cgltf_data* data = NULL;
+    if (cgltf_parse_file(&options, path, &data) != cgltf_result_success) {
+        gs_println("Warning: BSF::Unable to compute bounds for mesh: %s", path);
+        return gs_v4(0.f, 0.f, 0.f, FLT_MAX);
+    }
+
+    for (uint32_t m = 0; m < data->meshes_count; ++m)
+    {
+        cgltf_mesh* cmesh = &data->meshes[m];
+        for (uint32_t p = 0; p < cmesh->primitives_count; ++p)
+        {
+            cgltf_primitive* prim = &cmesh->primitives[p];
+            for (uint32_t a = 0; a < prim->attributes_count; ++a)
+            {
+                cgltf_attribute* attr = &prim->attributes[a];
+                if (attr->type != cgltf_attribute_type_position || !attr->data->has_min || !attr->data->has_max) continue;
+                for (uint32_t c = 0; c < 3; ++c) {
+                    mn.xyz[c] = gs_min(mn.xyz[c], attr->data->min[c]);
+                    mx.xyz[c] = gs_max(mx.xyz[c], attr->data->max[c]);
+                }
+            }
+        }
+    }
+    cgltf_free(data);
+
+    // Never cull what we couldn't bound
+    if (mn.x > mx.x) return gs_v4(0.f, 0.f, 0.f, FLT_MAX);
+
+    const gs_vec3 c = gs_vec3_scale(gs_vec3_add(mn, mx), 0.5f);
+    return gs_v4(c.x, c.y, c.z, gs_vec3_dist(c, mx));
+}
+
+static void bsf_assets_image_decode(void* data)
+{
+    // Every load passes flip = false, so stb's global flip flag never changes under another decode
+    bsf_asset_image_t* img = (bsf_asset_image_t*)data;
+    gs_util_load_texture_data_from_file(img->path, &img->width, &img->height, &img->num_comps, &img->data, false);
+    if (!img->data) {
+        gs_println("Warning: BSF::Unable to decode image: %s", img->path);
+    }
+    BSF_ATOMIC_STORE(&img->ready, true);
+}
+
+static void bsf_assets_bounds_compute(void* data)
+{
+    bsf_asset_load_t* load = (bsf_asset_load_t*)data;
+    load->bounds = bsf_graphics_mesh_bounds_from_file(load->path);
+    BSF_ATOMIC_STORE(&load->ready, true);
+}
+
+// Index of the decode of path, pushed on first request (faces sharing an image share its decode)
+static uint32_t bsf_assets_image_decode_push(bsf_t* bsf, bsf_assets_t* assets, const char* path)
+{
+    bsf_asset_stream_t* stream = &assets->stream;
+    gs_snprintfc(TMP, 256, "%s/%s", assets->asset_dir, path);
+    for (uint32_t i = 0; i < stream->image_count; ++i) {
+        if (gs_string_compare_equal(stream->images[i].path, TMP)) return i;
+    }
+
+    bsf_asset_image_t* img = &stream->images[stream->image_count];
+    memcpy(img->path, TMP, sizeof(img->path));
+
+    const bsf_asset_pack_entry_t* e = bsf_asset_pack_find(&assets->pack, path, BSF_ASSET_PACK_IMAGE);
+    if (e) {
+        img->width = e->width;
+        img->height = e->height;
+        img->num_comps = e->comps;
+        img->data = (void*)(assets->pack.data + e->offset);
+        img->packed = true;
+        img->ready = true;
+    } else {
+        bsf_jobs_push(&bsf->jobs, bsf_assets_image_decode, img);
+        stream->jobs++;
+    }
+    return stream->image_count++;
+}
+
+static void bsf_assets_mesh_layout_str(const gs_gfxt_pipeline_t* pip, char* buf, size_t sz)
+{
+    memset(buf, 0, sz);
+    for (uint32_t i = 0; i < gs_dyn_array_size(pip->mesh_layout); ++i)
+    {
+        const char* name = "UNKNOWN";
+        switch (pip->mesh_layout[i].type)
+        {
+            case GS_GFXT_MESH_ATTRIBUTE_TYPE_POSITION: name = "POSITION"; break;
+            case GS_GFXT_MESH_ATTRIBUTE_TYPE_NORMAL:   name = "NORMAL"; break;
+            case GS_GFXT_MESH_ATTRIBUTE_TYPE_TANGENT:  name = "TANGENT"; break;
+            case GS_GFXT_MESH_ATTRIBUTE_TYPE_TEXCOORD: name = "TEXCOORD"; break;
+            case GS_GFXT_MESH_ATTRIBUTE_TYPE_COLOR:    name = "COLOR"; break;
+            default: break;
+        }
+        const size_t len = strlen(buf);
+        gs_snprintf(buf + len, sz - len, "%s%s", i ? "," : "", name);
+    }
+}
+
+// Vertex and index buffers straight from the pack, false if the mesh isn't in it or was baked for another layout
+static bool32 bsf_assets_mesh_from_pack(const bsf_assets_t* assets, const char* path, const gs_gfxt_pipeline_t* pip, gs_gfxt_mesh_t* mesh)
+{
+    const bsf_asset_pack_entry_t* e = bsf_asset_pack_find(&assets->pack, path, BSF_ASSET_PACK_MESH);
+    if (!e) {
+        return false;
+    }
+
+    const uint8_t* base = assets->pack.data + e->offset;
+    const bsf_asset_pack_mesh_t* mh = (const bsf_asset_pack_mesh_t*)base;
+    char layout[sizeof(mh->layout)];
+    bsf_assets_mesh_layout_str(pip, layout, sizeof(layout));
+    if (strncmp(layout, mh->layout, sizeof(layout)) || mh->index_size != pip->desc.raster.index_buffer_element_size) {
+        gs_println("Warning: BSF::Packed mesh %s baked for %s, pipeline wants %s", path, mh->layout, layout);
+        return false;
+    }
+
+    // Every range inside the entry before any buffer is built from it
+    const bsf_asset_pack_primitive_t* prims = (const bsf_asset_pack_primitive_t*)(mh + 1);
+    bool32 valid = mh->primitive_count <= (e->size - sizeof(bsf_asset_pack_mesh_t)) / sizeof(bsf_asset_pack_primitive_t) && 
+        (mh->index_size == 2 || mh->index_size == 4);
+    for (uint32_t p = 0; valid && p < mh->primitive_count; ++p)
+    {
+        const bsf_asset_pack_primitive_t* pr = &prims[p];
+        valid = pr->vertex_offset <= e->size && pr->vertex_size <= e->size - pr->vertex_offset &&
+            pr->index_offset <= e->size && pr->index_size <= e->size - pr->index_offset &&
+            (uint64_t)pr->count * mh->index_size <= pr->index_size;
+    }
+    if (!valid) {
+        gs_println("Warning: BSF::Packed mesh %s is corrupt, loading the loose file", path);
+        return false;
+    }
+
+    memset(mesh, 0, sizeof(gs_gfxt_mesh_t));
+    for (uint32_t p = 0; p < mh->primitive_count; ++p)
+    {
+        gs_gfxt_mesh_primitive_t prim = {
+            .vbo = gs_graphics_vertex_buffer_create(&(gs_graphics_vertex_buffer_desc_t){
+                .data = (void*)(base + prims[p].vertex_offset),
+                .size = prims[p].vertex_size
+            }),
+            .indices = gs_graphics_index_buffer_create(&(gs_graphics_index_buffer_desc_t){
+                .data = (void*)(base + prims[p].index_offset),
+                .size = prims[p].index_size
+            }),
+            .count = prims[p].count
+        };
+        gs_dyn_array_push(mesh->primitives, prim);
+    }
+    return true;
+}
+
+// Everything in gs_asset_font_t after its texture, vertical metrics
+#define BSF_FONT_TAIL_OFFSET    (offsetof(gs_asset_font_t, texture) + sizeof(gs_asset_texture_t))
+#define BSF_FONT_TAIL_SIZE      (sizeof(gs_asset_font_t) - BSF_FONT_TAIL_OFFSET)
+
+// Atlas as written to the cache, also how the pack stores it
+static bool32 bsf_assets_font_from_memory(const uint8_t* data, size_t sz, uint64_t hash, uint32_t pt, bsf_asset_font_t* f)
+{
+    gs_asset_font_t* font = &f->font;
+    const bsf_font_cache_header_t* header = (const bsf_font_cache_header_t*)data;
+    const bool32 valid = sz >= sizeof(bsf_font_cache_header_t) && 
+        header->magic == BSF_FONT_CACHE_MAGIC && header->version == BSF_FONT_CACHE_VERSION &&
+        header->hash == hash && header->point_size == pt && header->font_size == sizeof(gs_asset_font_t) &&
+        sz == sizeof(bsf_font_cache_header_t) + sizeof(font->glyphs) + BSF_FONT_TAIL_SIZE + (size_t)header->width * header->height;
+    if (!valid) {
+        return false;
+    }
+
+    memset(font, 0, sizeof(gs_asset_font_t));
+    const uint8_t* p = (const uint8_t*)(header + 1);
+    memcpy(font->glyphs, p, sizeof(font->glyphs));
+    p += sizeof(font->glyphs);
+    memcpy((uint8_t*)font + BSF_FONT_TAIL_OFFSET, p, BSF_FONT_TAIL_SIZE);
+    p += BSF_FONT_TAIL_SIZE;
+
+    f->width = header->width;
+    f->height = header->height;
+    f->coverage = gs_malloc(f->width * f->height);
+    memcpy(f->coverage, p, f->width * f->height);
+    return true;
+}
+
+static bool32 bsf_assets_font_from_cache(const char* path, uint64_t hash, uint32_t pt, bsf_asset_font_t* f)
+{
+    size_t sz = 0;
+    uint8_t* data = (uint8_t*)gs_platform_read_file_contents(path, "rb", &sz);
+    if (!data) {
+        return false;
+    }
+    const bool32 valid = bsf_assets_font_from_memory(data, sz, hash, pt, f);
+    gs_free(data);
+    return valid;
+}
+
+static void bsf_assets_font_to_cache(const char* path, uint64_t hash, uint32_t pt, const bsf_asset_font_t* f)
+{
+    const gs_asset_font_t* font = &f->font;
+    const uint32_t w = f->width, h = f->height;
+    FILE* fp = fopen(path, "wb");
+    if (!fp) {
+        gs_println("Warning: BSF::Unable to write font cache: %s", path);
+        return;
+    }
+    const bsf_font_cache_header_t header = {
+        .magic = BSF_FONT_CACHE_MAGIC,
+        .version = BSF_FONT_CACHE_VERSION,
+        .hash = hash,
+        .point_size = pt,
+        .font_size = sizeof(gs_asset_font_t),
+        .width = w,
+        .height = h
+    };
+    fwrite(&header, sizeof(header), 1, fp);
+    fwrite(font->glyphs, sizeof(font->glyphs), 1, fp);
+    fwrite((const uint8_t*)font + BSF_FONT_TAIL_OFFSET, BSF_FONT_TAIL_SIZE, 1, fp);
+    fwrite(f->coverage, w * h, 1, fp);
+    fclose(fp);
+}
+
+static void bsf_assets_font_bake(void* data)
+{
+    // What gs_asset_font_load_from_memory does minus the texture, which needs the gpu context
+    bsf_asset_font_t* f = (bsf_asset_font_t*)data;
+    f->cached = (f->packed && bsf_assets_font_from_memory(f->packed, f->packed_size, f->hash, f->pt, f)) ||
+        bsf_assets_font_from_cache(f->cache, f->hash, f->pt, f);
+    if (!f->cached)
+    {
+        stbtt_fontinfo info = {0};
+        if (stbtt_InitFont(&info, (const uint8_t*)f->ttf, stbtt_GetFontOffsetForIndex((const uint8_t*)f->ttf, 0)))
+        {
+            f->width = f->height = BSF_FONT_ATLAS_SIZE;
+            f->coverage = gs_malloc(f->width * f->height);
+            memset(f->coverage, 0, f->width * f->height);
+            stbtt_BakeFontBitmap((const uint8_t*)f->ttf, 0, (float)f->pt, f->coverage, f->width, f->height, 32, 96, (stbtt_bakedchar*)f->font.glyphs);
+
+            int32_t ascent = 0, descent = 0, line_gap = 0;
+            const float scale = stbtt_ScaleForPixelHeight(&info, (float)f->pt);
+            stbtt_GetFontVMetrics(&info, &ascent, &descent, &line_gap);
+            f->font.ascent = (float)ascent * scale;
+            f->font.descent = (float)descent * scale;
+            f->font.line_gap = (float)line_gap * scale;
+            bsf_assets_font_to_cache(f->cache, f->hash, f->pt, f);
+        }
+        else
+        {
+            gs_println("Warning: BSF::Unable to bake font: %s", f->cache);
+        }
+    }
+    BSF_ATOMIC_STORE(&f->ready, true);
+}
+
+static void bsf_assets_font_land(bsf_asset_font_t* f)
+{
+    // Same white atlas gs builds, alpha from the coverage
+    const uint32_t count = f->width * f->height;
+    uint8_t* rgba = gs_malloc(count * 4);
+    for (uint32_t i = 0; i < count; ++i) {
+        rgba[i * 4 + 0] = rgba[i * 4 + 1] = rgba[i * 4 + 2] = 255;
+        rgba[i * 4 + 3] = f->coverage[i];
+    }
+    gs_graphics_texture_desc_t desc = {
+        .width = f->width,
+        .height = f->height,
+        .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
+        .min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
+        .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST
+    };
+    desc.data[0] = rgba;
+    f->font.texture.hndl = gs_graphics_texture_create(&desc);
+    desc.data[0] = NULL;
+    f->font.texture.desc = desc;
+    gs_free(rgba);
+}
+
+//=== BSF GL Backend ===//
+
+// gs_graphics has no accessors for the gl program or uniform names behind its handles. Everything the pipeline cache needs 
+// from the gl backend goes through the functions below, nothing else in the game touches gsgl_data_t or calls gl directly.
+
+static gsgl_data_t* bsf_gl_data()
+{
+    return (gsgl_data_t*)gs_subsystem(graphics)->user_data;
+}
+
+static uint64_t bsf_gl_driver_hash()
+{
+    const char* strs[] = {(const char*)glGetString(GL_VENDOR), (const char*)glGetString(GL_RENDERER), (const char*)glGetString(GL_VERSION)};
+    uint64_t hash = 0;
+    for (uint32_t i = 0; i < sizeof(strs) / sizeof(strs[0]); ++i) {
+        if (strs[i]) hash = (uint64_t)gs_hash_bytes((void*)strs[i], strlen(strs[i]), hash);
+    }
+    return hash;
+}
+
+static bool32 bsf_gl_program_binaries()
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count);
+    return count > 0;
+}
+
+// Links a stored program binary and registers it as a gs shader, false if the driver rejects it
+static bool32 bsf_gl_program_from_binary(uint32_t format, const void* binary, uint32_t size, gs_handle(gs_graphics_shader_t)* shader)
+{
+    if (!size || !bsf_gl_program_binaries()) {
+        return false;
+    }
+    const GLuint program = glCreateProgram();
+    glProgramBinary(program, format, binary, size);
+    GLint status = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (!status) {
+        glDeleteProgram(program);
+        return false;
+    }
+    *shader = gs_handle_create(gs_graphics_shader_t, gs_slot_array_insert(bsf_gl_data()->shaders, program));
+    return true;
+}
+
+// Glsl of each stage and, where supported, the program binary of a gs shader
+static bool32 bsf_gl_program_read(gs_handle(gs_graphics_shader_t) shader, bsf_gl_program_t* out)
+{
+    memset(out, 0, sizeof(bsf_gl_program_t));
+    const GLuint program = gs_slot_array_get(bsf_gl_data()->shaders, shader.id);
+
+    // gs deletes its shader objects after linking, they stay attached (and their source readable) until the program goes
+    GLuint shaders[GS_GRAPHICS_SHADER_STAGE_COUNT] = {0};
+    GLsizei count = 0;
+    glGetAttachedShaders(program, GS_GRAPHICS_SHADER_STAGE_COUNT, &count, shaders);
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        GLint type = 0, len = 0;
+        glGetShaderiv(shaders[i], GL_SHADER_TYPE, &type);
+        glGetShaderiv(shaders[i], GL_SHADER_SOURCE_LENGTH, &len);
+        char* glsl = gs_malloc(len + 1);
+        glGetShaderSource(shaders[i], len + 1, &len, glsl);
+        glsl[len] = '\0';
+        out->sources[i].type = type == GL_VERTEX_SHADER ? GS_GRAPHICS_SHADER_STAGE_VERTEX : GS_GRAPHICS_SHADER_STAGE_FRAGMENT;
+        out->sources[i].source = glsl;
+    }
+    out->source_count = (uint32_t)count;
+
+    if (bsf_gl_program_binaries())
+    {
+        GLint size = 0;
+        GLenum format = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+        out->binary = size > 0 ? gs_malloc(size) : NULL;
+        if (out->binary) {
+            glGetProgramBinary(program, size, &size, &format, out->binary);
+            out->binary_size = (uint32_t)size;
+            out->binary_format = (uint32_t)format;
+        }
+    }
+    return out->source_count > 0;
+}
+
+static void bsf_gl_program_free(bsf_gl_program_t* prog)
+{
+    for (uint32_t i = 0; i < prog->source_count; ++i) {
+        gs_free((void*)prog->sources[i].source);
+    }
+    gs_free(prog->binary);
+    memset(prog, 0, sizeof(bsf_gl_program_t));
+}
+
+// Name a uniform was declared with in its .sf
+static const char* bsf_gl_uniform_name(gs_handle(gs_graphics_uniform_t) uniform)
+{
+    return gs_slot_array_getp(bsf_gl_data()->uniforms, uniform.id)->name;
+}
+
+//=== BSF Assets ===//
+
+static bool32 bsf_assets_pipeline_from_cache(const char* path, uint64_t hash, gs_gfxt_pipeline_t* pip)
+{
+    size_t sz = 0;
+    uint8_t* data = (uint8_t*)gs_platform_read_file_contents(path, "rb", &sz);
+    if (!data) {
+        return false;
+    }
+
+    const bsf_pipeline_cache_header_t* header = (const bsf_pipeline_cache_header_t*)data;
+    bool32 valid = sz >= sizeof(bsf_pipeline_cache_header_t) && 
+        header->magic == BSF_PIPELINE_CACHE_MAGIC && header->version == BSF_PIPELINE_CACHE_VERSION &&
+        header->hash == hash && header->desc_size == sizeof(gs_graphics_pipeline_desc_t) && 
+        header->source_count && header->source_count <= GS_GRAPHICS_SHADER_STAGE_COUNT;
+
+    // Sources are variable length, walk them to check the size adds up
+    size_t fixed = sizeof(bsf_pipeline_cache_header_t) + sizeof(gs_graphics_pipeline_desc_t);
+    if (valid) {
+        fixed += (size_t)header->attr_count * sizeof(gs_graphics_vertex_attribute_desc_t) + 
+            (size_t)header->mesh_layout_count * sizeof(gs_gfxt_mesh_layout_t) + 
+            (size_t)header->uniform_count * sizeof(bsf_pipeline_cache_uniform_t);
+    }
+    const uint8_t* src = data + fixed;
+    for (uint32_t i = 0; valid && i < header->source_count; ++i) {
+        const bsf_pipeline_cache_source_t* s = (const bsf_pipeline_cache_source_t*)src;
+        valid = src + sizeof(bsf_pipeline_cache_source_t) <= data + sz && 
+            s->size && s->size <= (size_t)(data + sz - src) - sizeof(bsf_pipeline_cache_source_t) &&
+            ((const char*)(s + 1))[s->size - 1] == '\0';
+        if (valid) src += sizeof(bsf_pipeline_cache_source_t) + s->size;
+    }
+    valid = valid && src + header->binary_size == data + sz;
+    if (!valid) {
+        gs_free(data);
+        return false;
+    }
+
+    const uint8_t* p = data + sizeof(bsf_pipeline_cache_header_t);
+    gs_graphics_pipeline_desc_t desc = {0};
+    memcpy(&desc, p, sizeof(desc));
+    p += sizeof(desc);
+
+    // Owned by the pipeline's desc, same as a parsed one
+    const size_t attrs_size = header->attr_count * sizeof(gs_graphics_vertex_attribute_desc_t);
+    desc.layout.attrs = attrs_size ? gs_malloc(attrs_size) : NULL;
+    desc.layout.size = attrs_size;
+    if (attrs_size) memcpy(desc.layout.attrs, p, attrs_size);
+    p += attrs_size;
+
+    gs_dyn_array(gs_gfxt_mesh_layout_t) mesh_layout = NULL;
+    for (uint32_t i = 0; i < header->mesh_layout_count; ++i, p += sizeof(gs_gfxt_mesh_layout_t)) {
+        gs_gfxt_mesh_layout_t ml = {0};
+        memcpy(&ml, p, sizeof(ml));
+        gs_dyn_array_push(mesh_layout, ml);
+    }
+
+    // Slot order is kept, so uniform slots and material layouts match the parsed pipeline
+    gs_gfxt_uniform_desc_t* udescs = header->uniform_count ? gs_malloc(header->uniform_count * sizeof(gs_gfxt_uniform_desc_t)) : NULL;
+    for (uint32_t i = 0; i < header->uniform_count; ++i, p += sizeof(bsf_pipeline_cache_uniform_t)) {
+        const bsf_pipeline_cache_uniform_t* cu = (const bsf_pipeline_cache_uniform_t*)p;
+        memset(&udescs[i], 0, sizeof(gs_gfxt_uniform_desc_t));
+        memcpy(udescs[i].name, cu->name, sizeof(cu->name));
+        udescs[i].type = (gs_graphics_uniform_type)cu->type;
+        udescs[i].binding = cu->binding;
+    }
+
+    gs_graphics_shader_source_desc_t sources[GS_GRAPHICS_SHADER_STAGE_COUNT] = {0};
+    for (uint32_t i = 0; i < header->source_count; ++i) {
+        const bsf_pipeline_cache_source_t* s = (const bsf_pipeline_cache_source_t*)p;
+        sources[i].type = (gs_graphics_shader_stage_type)s->stage;
+        sources[i].source = (const char*)(s + 1);
+        p += sizeof(bsf_pipeline_cache_source_t) + s->size;
+    }
+
+    // Program binary when the driver takes it back, glsl compile otherwise (driver update between runs, or no binary formats)
+    gs_handle(gs_graphics_shader_t) shader = {0};
+    if (!bsf_gl_program_from_binary(header->binary_format, p, header->binary_size, &shader)) {
+        shader = gs_graphics_shader_create(&(gs_graphics_shader_desc_t){
+            .sources = sources,
+            .size = header->source_count * sizeof(gs_graphics_shader_source_desc_t),
+            .name = "bsf_pipeline_cache"
+        });
+    }
+    desc.raster.shader = shader;
+
+    *pip = gs_gfxt_pipeline_create(&(gs_gfxt_pipeline_desc_t){
+        .pip_desc = desc,
+        .ublock_desc = {.layout = udescs, .size = header->uniform_count * sizeof(gs_gfxt_uniform_desc_t)}
+    });
+    pip->desc = desc;
+    pip->mesh_layout = mesh_layout;
+
+    gs_free(udescs);
+    gs_free(data);
+    return true;
+}
+
+static void bsf_assets_pipeline_to_cache(const char* path, uint64_t hash, const gs_gfxt_pipeline_t* pip)
+{
+    bsf_gl_program_t prog = {0};
+    bool32 valid = bsf_gl_program_read(pip->desc.raster.shader, &prog);
+
+    bsf_pipeline_cache_uniform_t* uniforms = gs_malloc(gs_dyn_array_size(pip->ublock.uniforms) * sizeof(bsf_pipeline_cache_uniform_t) + 1);
+    for (uint32_t i = 0; valid && i < gs_dyn_array_size(pip->ublock.uniforms); ++i) 
+    {
+        const gs_gfxt_uniform_t* u = &pip->ublock.uniforms[i];
+        memset(&uniforms[i], 0, sizeof(bsf_pipeline_cache_uniform_t));
+        memcpy(uniforms[i].name, bsf_gl_uniform_name(u->hndl), sizeof(uniforms[i].name) - 1);
+        uniforms[i].type = (uint32_t)u->type;
+        uniforms[i].binding = (uint32_t)u->binding;
+        valid = uniforms[i].name[0] != '\0';
+    }
+
+    FILE* fp = valid ? fopen(path, "wb") : NULL;
+    if (!fp) {
+        gs_println("Warning: BSF::Unable to write pipeline cache: %s", path);
+        bsf_gl_program_free(&prog);
+        gs_free(uniforms);
+        return;
+    }
+
+    gs_graphics_pipeline_desc_t desc = pip->desc;
+    desc.layout.attrs = NULL;
+    desc.raster.shader.id = 0;
+    desc.compute.shader.id = 0;
+
+    const bsf_pipeline_cache_header_t header = {
+        .magic = BSF_PIPELINE_CACHE_MAGIC,
+        .version = BSF_PIPELINE_CACHE_VERSION,
+        .hash = hash,
+        .desc_size = sizeof(gs_graphics_pipeline_desc_t),
+        .attr_count = (uint32_t)(pip->desc.layout.size / sizeof(gs_graphics_vertex_attribute_desc_t)),
+        .mesh_layout_count = gs_dyn_array_size(pip->mesh_layout),
+        .uniform_count = gs_dyn_array_size(pip->ublock.uniforms),
+        .source_count = prog.source_count,
+        .binary_format = prog.binary_format,
+        .binary_size = prog.binary_size
+    };
+    fwrite(&header, sizeof(header), 1, fp);
+    fwrite(&desc, sizeof(desc), 1, fp);
+    if (pip->desc.layout.size) fwrite(pip->desc.layout.attrs, pip->desc.layout.size, 1, fp);
+    if (header.mesh_layout_count) fwrite(pip->mesh_layout, sizeof(gs_gfxt_mesh_layout_t), header.mesh_layout_count, fp);
+    if (header.uniform_count) fwrite(uniforms, sizeof(bsf_pipeline_cache_uniform_t), header.uniform_count, fp);
+
+    for (uint32_t i = 0; i < prog.source_count; ++i)
+    {
+        const bsf_pipeline_cache_source_t src = {
+            .stage = (uint32_t)prog.sources[i].type,
+            .size = (uint32_t)strlen(prog.sources[i].source) + 1
+        };
+        fwrite(&src, sizeof(src), 1, fp);
+        fwrite(prog.sources[i].source, src.size, 1, fp);
+    }
+    if (prog.binary_size) fwrite(prog.binary, prog.binary_size, 1, fp);
+    fclose(fp);
+
+    bsf_gl_program_free(&prog);
+    gs_free(uniforms);
+}
+
+static gs_gfxt_pipeline_t bsf_assets_pipeline_load(const char* path, bool32* cached)
+{
+    size_t sz = 0;
+    char* sf = gs_platform_read_file_contents(path, "rb", &sz);
+    const bool32 readable = sf != NULL;
+    const uint64_t hash = readable ? (uint64_t)gs_hash_bytes(sf, sz, bsf_gl_driver_hash()) : 0;
+    gs_free(sf);
+
+    gs_snprintfc(CACHE, 256, "%s.bsfp", path);
+    gs_gfxt_pipeline_t pip = {0};
+    *cached = readable && bsf_assets_pipeline_from_cache(CACHE, hash, &pip);
+    if (!*cached) {
+        pip = gs_gfxt_pipeline_load_from_file(path);
+        if (readable && pip.hndl.id) bsf_assets_pipeline_to_cache(CACHE, hash, &pip);
+    }
+    return pip;
+}
+
+GS_API_DECL bool32 bsf_asset_pack_open(bsf_asset_pack_t* pack, const char* path)
+{
+    memset(pack, 0, sizeof(bsf_asset_pack_t));
+    if (!gs_platform_file_exists(path)) {
+        return false;
+    }
+
+#ifdef BSF_ASSET_PACK_MMAP
+    struct stat st = {0};
+    const int32_t fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    void* data = fstat(fd, &st) == 0 && st.st_size > 0 ? mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (data == MAP_FAILED) {
+        gs_println("Warning: BSF::Unable to map asset pack: %s", path);
+        return false;
+    }
+    pack->data = (const uint8_t*)data;
+    pack->size = (size_t)st.st_size;
+    pack->mapped = true;
+#else
+    size_t sz = 0;
+    pack->data = (const uint8_t*)gs_platform_read_file_contents(path, "rb", &sz);
+    pack->size = sz;
+    if (!pack->data) {
+        return false;
+    }
+#endif
+
+    const bsf_asset_pack_header_t* header = (const bsf_asset_pack_header_t*)pack->data;
+    const bool32 valid = pack->size >= sizeof(bsf_asset_pack_header_t) && 
+        header->magic == BSF_ASSET_PACK_MAGIC && header->version == BSF_ASSET_PACK_VERSION &&
+        sizeof(bsf_asset_pack_header_t) + (size_t)header->count * sizeof(bsf_asset_pack_entry_t) <= pack->size;
+    if (!valid) {
+        gs_println("Warning: BSF::Ignoring asset pack with bad header: %s", path);
+        bsf_asset_pack_close(pack);
+        return false;
+    }
+
+    pack->entries = (const bsf_asset_pack_entry_t*)(header + 1);
+    pack->count = header->count;
+    gs_snprintf(pack->dir, sizeof(pack->dir), "%s", path);
+    char* slash = strrchr(pack->dir, '/');
+    if (slash) *slash = '\0';
+    else gs_snprintf(pack->dir, sizeof(pack->dir), ".");
+    return true;
+}
+
+static bool32 bsf_asset_pack_entry_stale(const bsf_asset_pack_t* pack, const bsf_asset_pack_entry_t* e)
+{
+#ifdef BSF_ASSET_PACK_MMAP
+    // Edited since the pack was baked. Missing loose files (shipped pack only) keep the entry.
+    gs_snprintfc(TMP, 256, "%s/%s", pack->dir, e->path);
+    struct stat st = {0};
+    if (stat(TMP, &st)) {
+        return false;
+    }
+    uint64_t size = (uint64_t)st.st_size, mtime = (uint64_t)st.st_mtime;
+
+    // Gltf buffers sit next to the gltf under the same name (tools/mesh_simplify.py)
+    char* ext = strrchr(TMP, '.');
+    if (e->type == BSF_ASSET_PACK_MESH && ext) {
+        gs_snprintf(ext, sizeof(TMP) - (ext - TMP), ".bin");
+        if (!stat(TMP, &st)) {
+            size += (uint64_t)st.st_size;
+            mtime = gs_max(mtime, (uint64_t)st.st_mtime);
+        }
+    }
+    return size != e->source_size || mtime != e->source_mtime;
+#else
+    // Packs ship with the build here, loose files aren't edited next to them
+    return false;
+#endif
+}
+
+static const bsf_asset_pack_entry_t* bsf_asset_pack_entry_checked(const bsf_asset_pack_t* pack, const bsf_asset_pack_entry_t* e)
+{
+    // Payload has to hold what readers of its type take for granted
+    uint64_t min_size = sizeof(bsf_asset_pack_mesh_t);
+    switch (e->type)
+    {
+        case BSF_ASSET_PACK_IMAGE: min_size = (uint64_t)e->width * e->height * e->comps; break;
+        case BSF_ASSET_PACK_FONT:  min_size = sizeof(bsf_font_cache_header_t) + (uint64_t)e->width * e->height; break;
+        default: break;
+    }
+    if (e->offset > pack->size || e->size > pack->size - e->offset || e->size < min_size) {
+        gs_println("Warning: BSF::Ignoring truncated pack entry %s", e->path);
+        return NULL;
+    }
+    if (bsf_asset_pack_entry_stale(pack, e)) {
+        gs_println("BSF::Pack entry %s is older than its source, loading the loose file", e->path);
+        return NULL;
+    }
+    return e;
+}
+
+GS_API_DECL const bsf_asset_pack_entry_t* bsf_asset_pack_find(const bsf_asset_pack_t* pack, const char* path, bsf_asset_pack_type type)
+{
+    for (uint32_t i = 0; i < pack->count; ++i)
+    {
+        const bsf_asset_pack_entry_t* e = &pack->entries[i];
+        if (e->type != type || strncmp(e->path, path, BSF_ASSET_PACK_PATH_MAX)) continue;
+        return bsf_asset_pack_entry_checked(pack, e);
+    }
+    return NULL;
+}
+
+GS_API_DECL const bsf_asset_pack_entry_t* bsf_asset_pack_find_font(const bsf_asset_pack_t* pack, const char* path, uint32_t pt)
+{
+    for (uint32_t i = 0; i < pack->count; ++i)
+    {
+        const bsf_asset_pack_entry_t* e = &pack->entries[i];
+        if (e->type != BSF_ASSET_PACK_FONT || e->comps != pt || strncmp(e->path, path, BSF_ASSET_PACK_PATH_MAX)) continue;
+        return bsf_asset_pack_entry_checked(pack, e);
+    }
+    return NULL;
+}
+
+GS_API_DECL void bsf_asset_pack_close(bsf_asset_pack_t* pack)
+{
+    if (pack->data)
+    {
+#ifdef BSF_ASSET_PACK_MMAP
+        munmap((void*)pack->data, pack->size);
+#else
+        gs_free((void*)pack->data);
+#endif
+    }
+    memset(pack, 0, sizeof(bsf_asset_pack_t));
+}
+
+static void bsf_assets_uniform_slots_fill(bsf_uniform_slots_t* slots)
+{
+    const gs_gfxt_pipeline_t* pip = slots->pip;
+    struct {const char* name; uint32_t* slot;} uniforms[] = {
+        {"u_mvp", &slots->u_mvp},
+        {"u_model", &slots->u_model},
+        {"u_tex", &slots->u_tex},
+        {"u_color", &slots->u_color},
+        {"u_scroll", &slots->u_scroll},
         {NULL}
     };
+    for (uint32_t i = 0; uniforms[i].name; ++i) {
+        const uint64_t hash = gs_hash_str64(uniforms[i].name);
+        *uniforms[i].slot = gs_hash_table_exists(pip->ublock.lookup, hash) ? 
+            gs_hash_table_get(pip->ublock.lookup, hash) : BSF_UNIFORM_SLOT_INVALID;
+    }
+}
+
+static bsf_asset_watch_t* bsf_assets_watch(bsf_assets_t* assets, bsf_asset_watch_type type, const char* key, const char* path)
+{
+    bsf_asset_watch_t w = {.type = type, .key = gs_hash_str64(key)};
+    gs_snprintf(w.path, sizeof(w.path), "%s", path);
+    gs_dyn_array_push(assets->reload.watches, w);
+    return &assets->reload.watches[gs_dyn_array_size(assets->reload.watches) - 1];
+}
+
+static void bsf_assets_watch_open(bsf_assets_t* assets)
+{
+    bsf_asset_reload_t* reload = &assets->reload;
+    reload->fd = -1;
+#ifdef BSF_ASSET_WATCH
+    // Close covers editors writing in place, moves cover editors and exporters replacing the file
+    reload->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (reload->fd < 0) {
+        gs_println("BSF::Asset watch unavailable, only P reloads (style sheets)");
+        return;
+    }
+    const char* dirs[] = {"pipelines", "textures", "meshes", "room_templates", "style_sheets", NULL};
+    for (uint32_t i = 0; dirs[i]; ++i)
+    {
+        gs_snprintfc(TMP, 256, "%s/%s", assets->asset_dir, dirs[i]);
+        const int32_t wd = inotify_add_watch(reload->fd, TMP, IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (wd < 0) continue;
+        reload->wds[reload->dir_count] = wd;
+        reload->dirs[reload->dir_count] = dirs[i];
+        reload->dir_count++;
+    }
+#endif
+}
+
+static void bsf_assets_room_template_read(const char* path, bsf_room_template_t* rt)
+{
+    if (!gs_platform_file_exists(path)) return;
+    gs_byte_buffer_t buffer = gs_byte_buffer_new();
+    gs_byte_buffer_read_from_file(&buffer, path); 
+    gs_byte_buffer_readc(&buffer, uint16_t, ct); 
+    for (uint32_t i = 0; i < ct; ++i)
+    {
+        gs_byte_buffer_readc(&buffer, bsf_room_brush_t, br);
+        gs_slot_array_insert(rt->brushes, br);
+    }
+    gs_byte_buffer_free(&buffer);
+}
+
+GS_API_DECL void bsf_assets_init(bsf_t* bsf, bsf_assets_t* assets)
+{
+    assets->asset_dir = gs_platform_dir_exists("./assets") ? "./assets" : "../assets";
+    const float t0 = gs_platform_elapsed_time();
+
+    // Anything in the pack skips decoding, everything else loads from loose files
+    gs_snprintfc(PACK, 256, "%s/bsf.pack", assets->asset_dir);
+    if (bsf_asset_pack_open(&assets->pack, PACK)) {
+        gs_println("BSF::Using asset pack %s (%u entries)", PACK, assets->pack.count);
+    }
+
+    struct {const char* key; const char* path; int32_t pt;} fonts[] = {
+        {.key = "font.arwing_h0", .path = "fonts/arwing.ttf", .pt = 90},
+        {.key = "font.arwing_h1", .path = "fonts/arwing.ttf", .pt = 32},
+        {.key = "font.arwing_h2", .path = "fonts/arwing.ttf", .pt = 24},
+        {.key = "font.arwing_p", .path = "fonts/arwing.ttf", .pt = 16},
+        {.key = "font.upheaval_h0", .path = "fonts/upheaval.ttf", .pt = 48},
+        {.key = "font.upheaval_h1", .path = "fonts/upheaval.ttf", .pt = 32},
+        {.key = "font.upheaval_h2", .path = "fonts/upheaval.ttf", .pt = 24},
+        {.key = "font.upheaval_p", .path = "fonts/upheaval.ttf", .pt = 16},
+        {NULL}
+    }; 
+
+    // Fonts go first, the title screen can't draw without them. Each ttf is read once for all its sizes, sizes
+    // rasterized before (same ttf hash) come from the pack or the atlas cache.
+    bsf_asset_font_t font_loads[sizeof(fonts) / sizeof(fonts[0])] = {0};
+    char* ttfs[sizeof(fonts) / sizeof(fonts[0])] = {0};
+    uint32_t ttf_count = 0;
+    const char* ttf_path = NULL;
+    size_t ttf_sz = 0;
+    uint64_t ttf_hash = 0;
+    for (uint32_t i = 0; fonts[i].key; ++i) 
+    {
+        bsf_asset_font_t* f = &font_loads[i];
+        gs_snprintfc(TMP, 256, "%s/%s", assets->asset_dir, fonts[i].path);
+        if (!ttf_path || !gs_string_compare_equal(ttf_path, fonts[i].path)) {
+            ttfs[ttf_count] = gs_platform_read_file_contents(TMP, "rb", &ttf_sz);
+            ttf_hash = ttfs[ttf_count] ? (uint64_t)gs_hash_bytes(ttfs[ttf_count], ttf_sz, 0) : 0;
+            ttf_path = fonts[i].path;
+            ttf_count++;
+        }
+
+        f->ttf = ttfs[ttf_count - 1];
+        f->hash = ttf_hash;
+        f->pt = (uint32_t)fonts[i].pt;
+        gs_snprintf(f->cache, sizeof(f->cache), "%s.%d.bsff", TMP, fonts[i].pt);
+        const bsf_asset_pack_entry_t* e = bsf_asset_pack_find_font(&assets->pack, fonts[i].path, f->pt);
+        if (e) {
+            f->packed = assets->pack.data + e->offset;
+            f->packed_size = e->size;
+        }
+        if (!f->ttf) {
+            gs_println("Warning: BSF::Unable to read font: %s", TMP);
+            f->ready = true;
+            continue;
+        }
+        bsf_jobs_push(&bsf->jobs, bsf_assets_font_bake, f);
+    }
+
+    struct {const char* key; const char* path; const char* pip;} meshes[] = {
+        {.key = "mesh.ship", .path = "meshes/ship.gltf", .pip = "pip.simple"}, 
+        {.key = "mesh.slave", .path = "meshes/slave.gltf", .pip = "pip.simple"}, 
+        {.key = "mesh.arwing", .path = "meshes/arwing.gltf", .pip = "pip.simple"}, 
+        {.key = "mesh.arwing64", .path = "meshes/arwing64.gltf", .pip = "pip.simple"}, 
+        {.key = "mesh.bandit", .path = "meshes/bandit.gltf", .pip = "pip.simple"}, 
+        {.key = "mesh.turret", .path = "meshes/turret.gltf", .pip = "pip.simple"}, 
+        {.key = "mesh.laser_player", .path = "meshes/laser_player.gltf", .pip = "pip.color"}, 
+        {.key = "mesh.brain", .path = "meshes/brain.gltf", .pip = "pip.simple"}, 
+        {.key = "mesh.brain_lod1", .path = "meshes/brain_lod1.gltf", .pip = "pip.simple"}, 
+        {.key = "mesh.brain_lod2", .path = "meshes/brain_lod2.gltf", .pip = "pip.simple"}, 
+        {NULL} 
+    };
+
+    // Minified on meshes, trilinear over a mip chain the gpu builds at upload (gs takes level 0 only)
+    gs_graphics_texture_desc_t desc = (gs_graphics_texture_desc_t) {
+        .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
+        .min_filter = GS_GRAPHICS_TEXTURE_FILTER_LINEAR,
+        .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_LINEAR,
+        .mip_filter = GS_GRAPHICS_TEXTURE_FILTER_LINEAR,
+        .num_mips = BSF_TEXTURE_MIPS_FULL,
+        .wrap_s = GS_GRAPHICS_TEXTURE_WRAP_CLAMP_TO_EDGE,
+        .wrap_t = GS_GRAPHICS_TEXTURE_WRAP_CLAMP_TO_EDGE
+    };
+
+    // Title screen textures first, the pool decodes in push order
+    struct {const char* key; const char* path; gs_graphics_texture_desc_t desc;} textures[] = {
+        {.key = "tex.title_bg", .path = "textures/title_bg.png", .desc = (gs_graphics_texture_desc_t){
+            .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
+            .min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
+            .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST
+        }},
+        {.key = "tex.vignette", .path = "textures/vignette.png", .desc = desc}, 
+        {.key = "tex.slave", .path = "textures/slave.png", .desc = desc}, 
+        {.key = "tex.arwing", .path = "textures/arwing.png", .desc = desc}, 
+        {.key = "tex.icon_inner_eye", .path = "textures/icon_inner_eye.png", .desc = (gs_graphics_texture_desc_t){
+            .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
+            .min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
+            .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST
+        }},
+        {.key = "tex.icon_polyphemus", .path = "textures/icon_polyphemus.png", .desc = (gs_graphics_texture_desc_t){
+            .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
+            .min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
+            .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST
+        }},
+        {.key = "tex.icon_spoon_bender", .path = "textures/icon_spoon_bender.png", .desc = (gs_graphics_texture_desc_t){
+            .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
+            .min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
+            .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST
+        }},
+        {.key = "tex.icon_sad_onion", .path = "textures/icon_sad_onion.png", .desc = (gs_graphics_texture_desc_t){
+            .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
+            .min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
+            .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST
+        }},
+        {.key = "tex.icon_magic_mushroom", .path = "textures/icon_magic_mushroom.png", .desc = (gs_graphics_texture_desc_t){
+            .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
+            .min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
+            .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST
+        }},
+        {NULL}
+    };
+
+    struct {const char* key; const char* paths[6];} cmaps[] = {
+        {
+            .key = "cmap.skybox",
+            .paths = {
+                "textures/sky_back.jpg", 
+                "textures/sky_back.jpg", 
+                "textures/sky_top.jpg", 
+                "textures/sky_bottom.jpg", 
+                "textures/sky_back.jpg", 
+                "textures/sky_back.jpg"
+            }
+        },
+        {NULL}
+    };
+
+    // Only what the title screen draws with is loaded here. Images decode and mesh bounds compute on the job pool, 
+    // meshes and sounds load on the main thread, and bsf_assets_stream swaps each into its table entry as it lands.
+    // Until then entries hold placeholders: tex.default, a unit cube in the mesh's layout, a black cubemap, silence.
+    bsf_asset_stream_t* stream = &assets->stream;
+    stream->t0 = t0;
+    uint32_t image_count = 0;
+    for (uint32_t i = 0; textures[i].key; ++i) image_count++;
+    for (uint32_t i = 0; cmaps[i].key; ++i) image_count += 6;
+    stream->images = gs_malloc(image_count * sizeof(bsf_asset_image_t));
+    memset(stream->images, 0, image_count * sizeof(bsf_asset_image_t));
+
+    const gs_gfxt_texture_t tex_default = gs_gfxt_texture_generate_default();
+    gs_hash_table_insert(assets->textures, gs_hash_str64("tex.default"), tex_default);
+
+    for (uint32_t i = 0; textures[i].key; ++i) 
+    {
+        bsf_asset_load_t load = {.type = BSF_ASSET_LOAD_TEXTURE, .key = gs_hash_str64(textures[i].key), .desc = textures[i].desc};
+        gs_snprintf(load.path, sizeof(load.path), "%s/%s", assets->asset_dir, textures[i].path);
+        load.images[0] = bsf_assets_image_decode_push(bsf, assets, textures[i].path);
+        gs_dyn_array_push(stream->loads, load);
+        gs_hash_table_insert(assets->textures, load.key, tex_default);
+        bsf_assets_watch(assets, BSF_ASSET_WATCH_TEXTURE, textures[i].key, textures[i].path)->desc = textures[i].desc;
+    }
+
+    uint32_t black = 0xff000000;
+    gs_graphics_texture_desc_t cmap_desc = { 
+        .type = GS_GRAPHICS_TEXTURE_CUBEMAP, 
+        .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
+        .width = 1,
+        .height = 1,
+        .min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
+        .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
+        .wrap_s = GS_GRAPHICS_TEXTURE_WRAP_CLAMP_TO_EDGE,
+        .wrap_t = GS_GRAPHICS_TEXTURE_WRAP_CLAMP_TO_EDGE,
+        .wrap_r = GS_GRAPHICS_TEXTURE_WRAP_CLAMP_TO_EDGE
+    };
+    for (uint32_t c = 0; c < 6; ++c) {
+        cmap_desc.data[c] = &black;
+    }
+    const gs_gfxt_texture_t cmap_default = gs_graphics_texture_create(&cmap_desc);
+
+    for (uint32_t i = 0; cmaps[i].key; ++i) 
+    {
+        bsf_asset_load_t load = {.type = BSF_ASSET_LOAD_CUBEMAP, .key = gs_hash_str64(cmaps[i].key), .desc = cmap_desc};
+        gs_snprintf(load.path, sizeof(load.path), "%s/%s", assets->asset_dir, cmaps[i].paths[0]);
+        for (uint32_t c = 0; c < 6; ++c) {
+            load.images[c] = bsf_assets_image_decode_push(bsf, assets, cmaps[i].paths[c]);
+        }
+        gs_dyn_array_push(stream->loads, load);
+        gs_hash_table_insert(assets->cubemaps, load.key, cmap_default);
+    }
+
+    // Room templates
+    struct {const char* key; const char* path;} room_templates[] = {
+        {.key = "rt.r0", .path = "room_templates/r0.rt"},
+        {.key = "rt.r1", .path = "room_templates/r1.rt"},
+        {.key = "rt.r2", .path = "room_templates/r2.rt"},
+        {.key = "rt.r3", .path = "room_templates/r3.rt"},
+        {.key = "rt.r4", .path = "room_templates/r4.rt"},
+        {.key = "rt.r5", .path = "room_templates/r5.rt"},
+        {.key = "rt.r6", .path = "room_templates/r6.rt"},
+        {.key = "rt.r7", .path = "room_templates/r7.rt"},
+        {.key = "rt.r8", .path = "room_templates/r8.rt"},
+        {.key = "rt.r9", .path = "room_templates/r9.rt"},
+        {NULL}
+    };
+
+    for (uint32_t i = 0; room_templates[i].key; ++i)
+    {
+        bsf_room_template_t rt = {0};
+        memcpy(rt.path, room_templates[i].path, 256);
+
+        gs_snprintfc(TMP, 256, "%s/%s", assets->asset_dir, room_templates[i].path); 
+        bsf_assets_room_template_read(TMP, &rt);
+        gs_hash_table_insert(assets->room_templates, gs_hash_str64(room_templates[i].key), rt);
+        bsf_assets_watch(assets, BSF_ASSET_WATCH_ROOM_TEMPLATE, room_templates[i].key, room_templates[i].path);
+    }
+
+    struct {const char* key; const char* path;} pipelines[] = {
+        {.key = "pip.simple", .path = "pipelines/simple.sf"},
+        {.key = "pip.color", .path = "pipelines/color.sf"},
+        {.key = "pip.gsi", .path = "pipelines/gsi.sf"},
+        {.key = "pip.skybox", .path = "pipelines/skybox.sf"},
+        {.key = "pip.simple_instanced", .path = "pipelines/simple_instanced.sf"},
+        {.key = "pip.color_instanced", .path = "pipelines/color_instanced.sf"},
+        {.key = "pip.world", .path = "pipelines/world.sf"},
+        {.key = "pip.gsi_instanced", .path = "pipelines/gsi_instanced.sf"},
+        {NULL}
+    };
+
+    // Pipelines parsed and compiled before (same .sf and driver) come from the cache
+    const float pip_t0 = gs_platform_elapsed_time();
+    uint32_t pip_cached = 0;
+    for (uint32_t i = 0; pipelines[i].key; ++i)
+    {
+        bool32 cached = false;
+        gs_snprintfc(TMP, 256, "%s/%s", assets->asset_dir, pipelines[i].path);
+        gs_hash_table_insert(assets->pipelines, gs_hash_str64(pipelines[i].key), bsf_assets_pipeline_load(TMP, &cached));
+        bsf_assets_watch(assets, BSF_ASSET_WATCH_PIPELINE, pipelines[i].key, pipelines[i].path);
+        pip_cached += cached;
+    }
+    gs_println("BSF::Loaded pipelines: %.2fms (%u cached)", gs_platform_elapsed_time() - pip_t0, pip_cached);
+
+    // Instanced twins, used by the scene for every group drawn with the base pipeline. Materials are laid out against
+    // the base pipeline's uniform block and bound through the twin, so a twin declares the base's uniforms too 
+    // (u_model/u_mvp) even though it takes the model from the instance.
+    struct {const char* pip; const char* instanced;} instanced_pipelines[] = {
+        {.pip = "pip.simple", .instanced = "pip.simple_instanced"},
+        {.pip = "pip.color", .instanced = "pip.color_instanced"},
+        {.pip = "pip.gsi", .instanced = "pip.gsi_instanced"},
+        {NULL}
+    };
+
+    for (uint32_t i = 0; instanced_pipelines[i].pip; ++i)
+    {
+        gs_gfxt_pipeline_t* pip = gs_hash_table_getp(assets->pipelines, gs_hash_str64(instanced_pipelines[i].pip));
+        gs_gfxt_pipeline_t* inst = gs_hash_table_getp(assets->pipelines, gs_hash_str64(instanced_pipelines[i].instanced));
+        gs_assert(bsf_graphics_pipeline_ublock_equal(pip, inst));
+        bsf_graphics_pipeline_make_instanced(inst);
+        bsf_render_instancing_register(&bsf->scene.instancing, pip, inst);
+    }
+
+    for (uint32_t i = 0; meshes[i].key; ++i)
+    {
+        gs_gfxt_pipeline_t* pip = gs_hash_table_getp(assets->pipelines, gs_hash_str64(meshes[i].pip));
+        const uint64_t pkey = (uint64_t)(uintptr_t)pip;
+        if (!gs_hash_table_exists(stream->placeholders, pkey)) {
+            gs_hash_table_insert(stream->placeholders, pkey, bsf_graphics_mesh_placeholder(pip));
+        }
+
+        bsf_asset_load_t load = {.type = BSF_ASSET_LOAD_MESH, .key = gs_hash_str64(meshes[i].key), .pip = pip};
+        gs_snprintf(load.path, sizeof(load.path), "%s/%s", assets->asset_dir, meshes[i].path);
+
+        // Packed bounds may go unused if the mesh turns out baked for another layout, the sphere is the same either way
+        const bsf_asset_pack_entry_t* e = bsf_asset_pack_find(&assets->pack, meshes[i].path, BSF_ASSET_PACK_MESH);
+        if (e) {
+            const float* b = ((const bsf_asset_pack_mesh_t*)(assets->pack.data + e->offset))->bounds;
+            load.bounds = gs_v4(b[0], b[1], b[2], b[3]);
+            load.ready = true;
+        }
+        gs_dyn_array_push(stream->loads, load);
+
+        // Shares the placeholder's buffers, never freed through this entry
+        gs_hash_table_insert(assets->meshes, load.key, gs_hash_table_get(stream->placeholders, pkey));
+        bsf_assets_watch(assets, BSF_ASSET_WATCH_MESH, meshes[i].key, meshes[i].path)->pip = pip;
+    }
+
+    // Placeholders are never culled, bounds land with the mesh
+    for (uint32_t i = 0; meshes[i].key; ++i)
+    {
+        gs_gfxt_mesh_t* mesh = gs_hash_table_getp(assets->meshes, gs_hash_str64(meshes[i].key));
+        gs_hash_table_insert(assets->mesh_bounds, (uint64_t)(uintptr_t)mesh, gs_v4(0.f, 0.f, 0.f, FLT_MAX));
+    }
+
+    // Detail levels (generated with tools/mesh_simplify.py). Bandit and turret are ~100 verts, not worth reducing.
+    struct {const char* levels[BSF_MESH_LOD_MAX]; float sizes[BSF_MESH_LOD_MAX];} mesh_lods[] = {
+        {.levels = {"mesh.brain", "mesh.brain_lod1", "mesh.brain_lod2"}, .sizes = {0.25f, 0.08f, 0.f}},
+        {NULL}
+    };
+
+    for (uint32_t i = 0; mesh_lods[i].levels[0]; ++i)
+    {
+        bsf_mesh_lod_t lod = {0};
+        for (uint32_t l = 0; l < BSF_MESH_LOD_MAX && mesh_lods[i].levels[l]; ++l) {
+            lod.levels[l] = gs_hash_table_getp(assets->meshes, gs_hash_str64(mesh_lods[i].levels[l]));
+            lod.sizes[l] = mesh_lods[i].sizes[l];
+            lod.count++;
+        }
+        gs_hash_table_insert(assets->mesh_lods, (uint64_t)(uintptr_t)lod.levels[0], lod);
+    }
+
+    // Sounds
+    struct {const char* key; const char* path;} sounds[] = {
+        {"audio.laser", "sounds/arwing_laser.mp3"},
+        {"audio.laser2", "sounds/laser2.wav"},
+        {"audio.bang", "sounds/bang.mp3"},
+        {"audio.explosion", "sounds/explosion.mp3"},
+        {"audio.explosion_boss", "sounds/explosion_boss.mp3"},
+        {"audio.health_pickup", "sounds/pickup.mp3"},
+        {"audio.bomb_pickup", "sounds/bomb_pickup.mp3"},
+        {"audio.menu_select", "sounds/menu_select.mp3"},
+        {"audio.start", "sounds/start.mp3"},
+        {"audio.pause", "sounds/pause.mp3"},
+        {"audio.arwing_hit", "sounds/arwing_hit.mp3"},
+        {"audio.hit_no_damage", "sounds/hit_no_damage.mp3"},
+        {NULL}
+    };
+
+    for (uint32_t i = 0; sounds[i].key; ++i)
+    {
+        bsf_asset_load_t load = {.type = BSF_ASSET_LOAD_SOUND, .key = gs_hash_str64(sounds[i].key)};
+        gs_snprintf(load.path, sizeof(load.path), "%s/%s", assets->asset_dir, sounds[i].path);
+        gs_dyn_array_push(stream->loads, load);
+
+        // Invalid source, bsf_play_sound skips it
+        gs_asset_audio_t snd = {0};
+        snd.hndl.id = UINT32_MAX;
+        gs_hash_table_insert(assets->sounds, load.key, snd);
+    }
+
+    // Loads are final, jobs can point into them from here on
+    for (uint32_t i = 0; i < gs_dyn_array_size(stream->loads); ++i)
+    {
+        bsf_asset_load_t* load = &stream->loads[i];
+        if (load->type == BSF_ASSET_LOAD_MESH && !load->ready) {
+            bsf_jobs_push(&bsf->jobs, bsf_assets_bounds_compute, load);
+            stream->jobs++;
+        }
+    }
+
+    // Streamed by bsf_music_t, nothing decoded here
+    struct {const char* key; const char* path;} music[] = {
+        {"music.boss", "sounds/music_boss.mp3"},
+        {"music.title", "sounds/music_title.mp3"},
+        {"music.level", "sounds/music_level.mp3"},
+        {"music.level_complete", "sounds/music_level_complete.mp3"},
+        {NULL}
+    };
+
+    for (uint32_t i = 0; music[i].key; ++i)
+    {
+        bsf_music_track_t track = {0};
+        gs_snprintf(track.path, sizeof(track.path), "%s/%s", assets->asset_dir, music[i].path);
+        gs_hash_table_insert(assets->music, gs_hash_str64(music[i].key), track);
+    }
+
+    struct {const char* key; const char* pip;} materials[] = {
+        {.key = "mat.simple", .pip = "pip.simple"},
+        {.key = "mat.color", .pip = "pip.color"},
+        {.key = "mat.gsi", .pip = "pip.gsi"},
+        {.key = "mat.gui", .pip = "pip.gsi"},       // Gui callbacks, kept apart from mat.gsi which the render thread uses
+        {.key = "mat.skybox", .pip = "pip.skybox"},
+        {.key = "mat.world", .pip = "pip.world"},
+        {NULL}
+    };
+
+    for (uint32_t i = 0; materials[i].key; ++i)
+    {
+        gs_gfxt_pipeline_t* pip = gs_hash_table_getp(assets->pipelines, gs_hash_str64(materials[i].pip));
+        gs_hash_table_insert(assets->materials, gs_hash_str64(materials[i].key), gs_gfxt_material_create(&(gs_gfxt_material_desc_t){.pip_func.hndl = pip}));
+    } 
+
+    struct {const char* key; const char* mat;} material_instances[] = {
+        {.key = "mat.ship_arwing", .mat = "mat.simple"},
+        {.key = "mat.slave", .mat = "mat.simple"},
+        {.key = "mat.bandit", .mat = "mat.simple"},
+        {.key = "mat.turret", .mat = "mat.simple"},
+        {.key = "mat.laser", .mat = "mat.color"},
+        {.key = "mat.sky_sphere", .mat = "mat.color"},
+        {.key = "mat.brain", .mat = "mat.simple"},
+        {NULL}
+    }; 
+
+    for (uint32_t i = 0; material_instances[i].key; ++i)
+    {
+        gs_gfxt_material_t* mat = gs_hash_table_getp(assets->materials, gs_hash_str64(material_instances[i].mat));
+        gs_gfxt_material_t inst = gs_gfxt_material_deep_copy(mat);
+        gs_hash_table_insert(assets->materials, gs_hash_str64(material_instances[i].key), inst);
+    } 
+    
+    // Fonts baked on the pool while the above loaded, atlases go up here (the title screen needs them)
+    uint32_t cached = 0;
+    for (uint32_t i = 0; fonts[i].key; ++i)
+    {
+        bsf_asset_font_t* f = &font_loads[i];
+        while (!BSF_ATOMIC_LOAD(&f->ready)) {
+            gs_platform_sleep(0.1f);
+        }
+        gs_asset_font_t* font = gs_malloc_init(gs_asset_font_t);
+        if (f->coverage) {
+            bsf_assets_font_land(f);
+            *font = f->font;
+            cached += f->cached;
+        }
+        gs_free(f->coverage);
+        gs_hash_table_insert(bsf->gs.gui.font_stash, gs_hash_str64(fonts[i].key), font);
+    }
+    for (uint32_t i = 0; i < ttf_count; ++i) {
+        gs_free(ttfs[i]);
+    }
+    gs_println("BSF::Loaded fonts: %.2fms after init started (%u from pack or cache)", gs_platform_elapsed_time() - t0, cached);
+
+    // Skybox
+    {
+        // Vertex data for skybox
+        float v_data[] = {
+            -1.0f,  1.0f,  1.0f, 
+            -1.0f, -1.0f,  1.0f, 
+             1.0f, -1.0f,  1.0f,
+             1.0f,  1.0f,  1.0f, 
+            -1.0f,  1.0f, -1.0f, 
+            -1.0f, -1.0f, -1.0f, 
+             1.0f, -1.0f, -1.0f, 
+             1.0f,  1.0f, -1.0f 
+        };
+
+        uint16_t i_data[] = {
+           0, 1, 2, 3,
+           3, 2, 6, 7,
+           7, 6, 5, 4,
+           4, 5, 1, 0,
+           0, 3, 7, 4, // T
+           1, 2, 6, 5  // B
+        };
+
+        bsf_model_t skybox = {0}; 
+
+        // Skybox vbo/ibo
+        skybox.vbo = gs_graphics_vertex_buffer_create(&(gs_graphics_vertex_buffer_desc_t){
+            .data = v_data,
+            .size = sizeof(v_data)
+        });
+
+        skybox.ibo = gs_graphics_index_buffer_create(&(gs_graphics_index_buffer_desc_t){
+            .data = i_data, 
+            .size = sizeof(i_data)
+        });
+
+        skybox.material = gs_hash_table_getp(assets->materials, gs_hash_str64("mat.skybox"));
+
+        gs_hash_table_insert(assets->models, gs_hash_str64("models.skybox"), skybox);
+    } 
+
+    struct {const char* key; const char* path;} style_sheets[] = {
+        {.key = "ss.title", .path = "style_sheets/bsf_title.ss"},
+        {NULL}
+    }; 
+
+    for (uint32_t i = 0; style_sheets[i].key; ++i)
+    {
+        gs_snprintfc(TMP, 256, "%s/%s", assets->asset_dir, style_sheets[i].path);
+        gs_gui_style_sheet_t ss = gs_gui_style_sheet_load_from_file(&bsf->gs.gui, TMP);
+        gs_hash_table_insert(assets->style_sheets, gs_hash_str64(style_sheets[i].key), ss);
+        bsf_assets_watch(assets, BSF_ASSET_WATCH_STYLE_SHEET, style_sheets[i].key, style_sheets[i].path);
+    }
+    bsf_assets_watch_open(assets);
+
+    // Resolve handles, tables aren't inserted into after this so pointers stay valid
+    #define X(TABLE, T, NAME, KEY)\
+        assets->hndl.NAME = gs_hash_table_getp(assets->TABLE, gs_hash_str64(KEY));\
+        gs_assert(assets->hndl.NAME);
+    BSF_ASSET_HANDLES(X)
+    #undef X
+
+    // Uniform slots for every pipeline
+    for (
+        gs_hash_table_iter it = gs_hash_table_iter_new(assets->pipelines);
+        gs_hash_table_iter_valid(assets->pipelines, it);
+        gs_hash_table_iter_advance(assets->pipelines, it)
+    )
+    {
+        bsf_uniform_slots_t slots = {.pip = gs_hash_table_iter_getp(assets->pipelines, it)};
+        bsf_assets_uniform_slots_fill(&slots);
+        gs_dyn_array_push(assets->uniform_slots, slots);
+        gs_dyn_array_push(assets->uniform_slot_pips, slots.pip);
+    }
+
+    // Lasers of both teams share a material (and batch), team color comes from the renderable tint
+    BSF_MATERIAL_SET_UNIFORM(assets, assets->hndl.mat_laser, u_color, &(gs_vec3){1.f, 1.f, 1.f});
+
+    gs_println("BSF::Loaded title assets: %.2fms, streaming %u more (%u decode jobs on %u threads)", gs_platform_elapsed_time() - t0, 
+        gs_dyn_array_size(stream->loads), stream->jobs, bsf->jobs.thread_count);
+}
+
+static uint32_t bsf_assets_mip_count(uint32_t width, uint32_t height)
+{
+    uint32_t count = 1;
+    for (uint32_t sz = gs_max(width, height); sz > 1; sz >>= 1) {
+        count++;
+    }
+    return count;
+}
+
+static bool32 bsf_assets_load_ready(const bsf_asset_stream_t* stream, const bsf_asset_load_t* load)
+{
+    switch (load->type)
+    {
+        case BSF_ASSET_LOAD_TEXTURE: return BSF_ATOMIC_LOAD(&stream->images[load->images[0]].ready);
+        case BSF_ASSET_LOAD_MESH:    return BSF_ATOMIC_LOAD(&load->ready);
+        case BSF_ASSET_LOAD_CUBEMAP:
+        {
+            for (uint32_t c = 0; c < 6; ++c) {
+                if (!BSF_ATOMIC_LOAD(&stream->images[load->images[c]].ready)) return false;
+            }
+            return true;
+        }
+        default: return true;
+    }
+}
+
+// Creates the resource and overwrites the placeholder, a failed load keeps it
+static void bsf_assets_load_land(bsf_assets_t* assets, const bsf_asset_load_t* load)
+{
+    const bsf_asset_stream_t* stream = &assets->stream;
+    switch (load->type)
+    {
+        case BSF_ASSET_LOAD_TEXTURE:
+        {
+            const bsf_asset_image_t* img = &stream->images[load->images[0]];
+            if (!img->data) break;
+            gs_graphics_texture_desc_t desc = load->desc;
+            desc.width = img->width;
+            desc.height = img->height;
+            desc.data[0] = img->data;
+            if (img->packed && img->num_comps == 3) {
+                desc.format = GS_GRAPHICS_TEXTURE_FORMAT_RGB8;      // Opaque, baked without alpha
+            }
+            if (desc.num_mips == BSF_TEXTURE_MIPS_FULL) {
+                desc.num_mips = bsf_assets_mip_count(img->width, img->height);
+            }
+            *gs_hash_table_getp(assets->textures, load->key) = gs_graphics_texture_create(&desc);
+        } break;
+
+        case BSF_ASSET_LOAD_CUBEMAP:
+        {
+            gs_graphics_texture_desc_t desc = load->desc;
+            for (uint32_t c = 0; c < 6; ++c)
+            {
+                const bsf_asset_image_t* img = &stream->images[load->images[c]];
+                if (!img->data) return;
+                desc.data[c] = img->data;
+                if (c == 0) {
+                    desc.width = img->width;
+                    desc.height = img->height;
+                    desc.format = img->num_comps == 3 ? GS_GRAPHICS_TEXTURE_FORMAT_RGB8 : GS_GRAPHICS_TEXTURE_FORMAT_RGBA8;
+                } else {
+                    gs_assert(img->width == desc.width); 
+                    gs_assert(img->height == desc.height);
+                    gs_assert(img->num_comps == stream->images[load->images[0]].num_comps);
+                }
+            }
+            *gs_hash_table_getp(assets->cubemaps, load->key) = gs_graphics_texture_create(&desc);
+        } break;
+
+        case BSF_ASSET_LOAD_MESH:
+        {
+            const gs_gfxt_pipeline_t* pip = load->pip;
+            const char* rel = load->path + strlen(assets->asset_dir) + 1;
+            gs_gfxt_mesh_t mesh = {0};
+            if (!bsf_assets_mesh_from_pack(assets, rel, pip, &mesh)) {
+                mesh = gs_gfxt_mesh_load_from_file(load->path, &(gs_gfxt_mesh_import_options_t){
+                    .layout = pip->mesh_layout,
+                    .size = gs_dyn_array_size(pip->mesh_layout) * sizeof(gs_gfxt_mesh_layout_t),
+                    .index_buffer_element_size = pip->desc.raster.index_buffer_element_size
+                });
+            }
+            gs_gfxt_mesh_t* dst = gs_hash_table_getp(assets->meshes, load->key);
+            *dst = mesh;
+            *gs_hash_table_getp(assets->mesh_bounds, (uint64_t)(uintptr_t)dst) = load->bounds;
+        } break;
+
+        case BSF_ASSET_LOAD_SOUND:
+        {
+            // Decode stays here: gs_asset_audio_load_from_file decodes and inserts the source into gs_audio's slot array 
+            // in one call, and gs has no entry point to register pcm decoded elsewhere. Spread over frames by the budget.
+            gs_asset_audio_t snd = {0};
+            gs_asset_audio_load_from_file(load->path, &snd);
+            *gs_hash_table_getp(assets->sounds, load->key) = snd;
+        } break;
+    }
+}
+
+GS_API_DECL void bsf_assets_stream(bsf_assets_t* assets)
+{
+    bsf_asset_stream_t* stream = &assets->stream;
+    if (bsf_assets_loaded(assets)) {
+        return;
+    }
+
+    // Whatever is ready, until the frame's budget is spent (always at least one)
+    const float t0 = gs_platform_elapsed_time();
+    for (uint32_t i = 0; i < gs_dyn_array_size(stream->loads) && gs_platform_elapsed_time() - t0 < BSF_ASSET_STREAM_BUDGET; ++i)
+    {
+        bsf_asset_load_t* load = &stream->loads[i];
+        if (load->done || !bsf_assets_load_ready(stream, load)) continue;
+        bsf_assets_load_land(assets, load);
+        load->done = true;
+        stream->done++;
+    }
+
+    if (!bsf_assets_loaded(assets)) {
+        return;
+    }
+
+    // Decodes are uploaded and packed data is on the gpu
+    for (uint32_t i = 0; i < stream->image_count; ++i) {
+        if (!stream->images[i].packed) gs_free(stream->images[i].data);
+    }
+    gs_free(stream->images);
+    stream->images = NULL;
+    stream->image_count = 0;
+    bsf_asset_pack_close(&assets->pack);
+
+    gs_println("BSF::Streamed assets: %.2fms after init started", gs_platform_elapsed_time() - stream->t0);
+}
+
+GS_API_DECL void bsf_assets_stream_free(bsf_assets_t* assets)
+{
+    // Quit before streaming finished, decodes that never landed still own their data
+    bsf_asset_stream_t* stream = &assets->stream;
+    for (uint32_t i = 0; i < stream->image_count; ++i) {
+        if (!stream->images[i].packed) gs_free(stream->images[i].data);
+    }
+    gs_free(stream->images);
+    stream->images = NULL;
+    stream->image_count = 0;
+    gs_dyn_array_free(stream->loads);
+    stream->loads = NULL;
+    stream->done = 0;
+    gs_hash_table_free(stream->placeholders);
+    bsf_asset_pack_close(&assets->pack);
+}
+
+GS_API_DECL bool32 bsf_assets_loaded(const bsf_assets_t* assets)
+{
+    return assets->stream.done == gs_dyn_array_size(assets->stream.loads);
+}
+
+GS_API_DECL float bsf_assets_progress(const bsf_assets_t* assets)
+{
+    const uint32_t count = gs_dyn_array_size(assets->stream.loads);
+    return count ? (float)assets->stream.done / (float)count : 1.f;
+}
+
+// Index into uniform_slots, UINT32_MAX for a pipeline outside the asset table. Scans a handful of packed pointers 
+// rather than hashing, gs hash lookups write the table's tmp_key and slots are read from the main and render threads.
+static uint32_t bsf_assets_uniform_slots_index(const bsf_assets_t* assets, const gs_gfxt_pipeline_t* pip)
+{
+    for (uint32_t i = 0; i < gs_dyn_array_size(assets->uniform_slot_pips); ++i) {
+        if (assets->uniform_slot_pips[i] == pip) return i;
+    }
+    return UINT32_MAX;
+}
+
+GS_API_DECL const bsf_uniform_slots_t* bsf_assets_uniform_slots(const bsf_assets_t* assets, const gs_gfxt_material_t* mat)
+{
+    // Unknown pipeline, every uniform set through it is skipped
+    static const bsf_uniform_slots_t invalid = {
+        .u_mvp = BSF_UNIFORM_SLOT_INVALID,
+        .u_model = BSF_UNIFORM_SLOT_INVALID,
+        .u_tex = BSF_UNIFORM_SLOT_INVALID,
+        .u_color = BSF_UNIFORM_SLOT_INVALID,
+        .u_scroll = BSF_UNIFORM_SLOT_INVALID
+    };
+    const gs_gfxt_pipeline_t* pip = GS_GFXT_RAW_DATA(&mat->desc.pip_func, gs_gfxt_pipeline_t);
+    const uint32_t idx = bsf_assets_uniform_slots_index(assets, pip);
+    gs_assert(idx != UINT32_MAX);
+    return idx != UINT32_MAX ? &assets->uniform_slots[idx] : &invalid;
+}
+
+GS_API_DECL void bsf_material_set_uniform_slot(gs_gfxt_material_t* mat, uint32_t slot, const void* data)
+{
+    // Same as gs_gfxt_material_set_uniform, minus the name lookup
+    if (slot == BSF_UNIFORM_SLOT_INVALID) return;
+    gs_gfxt_pipeline_t* pip = gs_gfxt_material_get_pipeline(mat);
+    gs_gfxt_uniform_t* u = &pip->ublock.uniforms[slot];
+    switch (u->type)
+    {
+        case GS_GRAPHICS_UNIFORM_SAMPLER2D:
+        case GS_GRAPHICS_UNIFORM_SAMPLERCUBE:
+        {
+            const gs_gfxt_texture_t* tex = (const gs_gfxt_texture_t*)data;
+            gs_byte_buffer_seek_to_beg(&mat->image_buffer_data);
+            gs_byte_buffer_advance_position(&mat->image_buffer_data, u->offset);
+            gs_byte_buffer_write(&mat->image_buffer_data, uint32_t, tex->id);
+        } break;
+
+        default:
+        {
+            gs_byte_buffer_seek_to_beg(&mat->uniform_data);
+            gs_byte_buffer_advance_position(&mat->uniform_data, u->offset);
+            gs_byte_buffer_write_bulk(&mat->uniform_data, data, u->size);
+        } break;
+    }
+}
+
+static void bsf_assets_retire(bsf_assets_t* assets, bsf_asset_retired_t r)
+{
+    // The frame extracted before the swap is still submitted on the next render
+    r.frames = 1;
+    gs_dyn_array_push(assets->reload.retired, r);
+}
+
+static void bsf_assets_retired_destroy(bsf_asset_retired_t* r)
+{
+    switch (r->type)
+    {
+        case BSF_ASSET_WATCH_TEXTURE: gs_graphics_texture_destroy(r->texture); break;
+        case BSF_ASSET_WATCH_PIPELINE: gs_gfxt_pipeline_destroy(&r->pipeline); break;
+        case BSF_ASSET_WATCH_MESH:
+        {
+            for (uint32_t p = 0; p < gs_dyn_array_size(r->mesh.primitives); ++p) {
+                gs_graphics_vertex_buffer_destroy(r->mesh.primitives[p].vbo);
+                gs_graphics_index_buffer_destroy(r->mesh.primitives[p].indices);
+            }
+            gs_dyn_array_free(r->mesh.primitives);
+        } break;
+        default: break;
+    }
+}
+
+static void bsf_assets_materials_rebind(bsf_assets_t* assets, uint32_t old_id, uint32_t new_id)
+{
+    // Samplers hold texture ids, swap every reference to the old one
+    for (
+        gs_hash_table_iter it = gs_hash_table_iter_new(assets->materials);
+        gs_hash_table_iter_valid(assets->materials, it);
+        gs_hash_table_iter_advance(assets->materials, it)
+    )
+    {
+        gs_gfxt_material_t* mat = gs_hash_table_iter_getp(assets->materials, it);
+        const gs_gfxt_pipeline_t* pip = gs_gfxt_material_get_pipeline(mat);
+        for (uint32_t i = 0; i < gs_dyn_array_size(pip->ublock.uniforms); ++i)
+        {
+            const gs_gfxt_uniform_t* u = &pip->ublock.uniforms[i];
+            if (u->type != GS_GRAPHICS_UNIFORM_SAMPLER2D && u->type != GS_GRAPHICS_UNIFORM_SAMPLERCUBE) continue;
+            if (u->offset + sizeof(uint32_t) > mat->image_buffer_data.size) continue;
+            uint32_t* id = (uint32_t*)(mat->image_buffer_data.data + u->offset);
+            if (*id == old_id) *id = new_id;
+        }
+    }
+}
+
+static void bsf_assets_material_rebuild(gs_gfxt_material_t* mat, const gs_gfxt_pipeline_t* old)
+{
+    // Reloaded pipeline may lay out its uniform block differently, values carry over by name
+    gs_gfxt_pipeline_t* pip = gs_gfxt_material_get_pipeline(mat);
+    gs_gfxt_material_t fresh = gs_gfxt_material_create(&(gs_gfxt_material_desc_t){.pip_func.hndl = pip});
+    for (
+        gs_hash_table_iter it = gs_hash_table_iter_new(old->ublock.lookup);
+        gs_hash_table_iter_valid(old->ublock.lookup, it);
+        gs_hash_table_iter_advance(old->ublock.lookup, it)
+    )
+    {
+        const uint64_t name = gs_hash_table_iter_getk(old->ublock.lookup, it);
+        if (!gs_hash_table_exists(pip->ublock.lookup, name)) continue;
+        const gs_gfxt_uniform_t* ou = &old->ublock.uniforms[gs_hash_table_iter_get(old->ublock.lookup, it)];
+        const uint32_t slot = gs_hash_table_get(pip->ublock.lookup, name);
+        const gs_gfxt_uniform_t* u = &pip->ublock.uniforms[slot];
+        if (u->type != ou->type) continue;
+        switch (u->type)
+        {
+            case GS_GRAPHICS_UNIFORM_SAMPLER2D:
+            case GS_GRAPHICS_UNIFORM_SAMPLERCUBE:
+            {
+                if (ou->offset + sizeof(uint32_t) > mat->image_buffer_data.size) break;
+                const gs_gfxt_texture_t tex = {.id = *(uint32_t*)(mat->image_buffer_data.data + ou->offset)};
+                bsf_material_set_uniform_slot(&fresh, slot, &tex);
+            } break;
+
+            default:
+            {
+                if (u->size != ou->size || ou->offset + ou->size > mat->uniform_data.size) break;
+                bsf_material_set_uniform_slot(&fresh, slot, mat->uniform_data.data + ou->offset);
+            } break;
+        }
+    }
+    gs_byte_buffer_free(&mat->uniform_data);
+    gs_byte_buffer_free(&mat->image_buffer_data);
+    *mat = fresh;
+}
+
+GS_API_DECL bool32 bsf_graphics_pipeline_ublock_equal(const gs_gfxt_pipeline_t* a, const gs_gfxt_pipeline_t* b)
+{
+    // Same names in the same slots with the same layout, so a material of either binds through the other
+    if (gs_dyn_array_size(a->ublock.uniforms) != gs_dyn_array_size(b->ublock.uniforms)) return false;
+    for (uint32_t i = 0; i < gs_dyn_array_size(a->ublock.uniforms); ++i)
+    {
+        const gs_gfxt_uniform_t* ua = &a->ublock.uniforms[i];
+        const gs_gfxt_uniform_t* ub = &b->ublock.uniforms[i];
+        if (ua->type != ub->type || ua->offset != ub->offset || ua->size != ub->size) return false;
+    }
+    for (
+        gs_hash_table_iter it = gs_hash_table_iter_new(a->ublock.lookup);
+        gs_hash_table_iter_valid(a->ublock.lookup, it);
+        gs_hash_table_iter_advance(a->ublock.lookup, it)
+    )
+    {
+        const uint64_t name = gs_hash_table_iter_getk(a->ublock.lookup, it);
+        if (!gs_hash_table_exists(b->ublock.lookup, name)) return false;
+        if (gs_hash_table_get(b->ublock.lookup, name) != gs_hash_table_iter_get(a->ublock.lookup, it)) return false;
+    }
+    return true;
+}
+
+static void bsf_assets_reload_watch(bsf_t* bsf, bsf_asset_watch_t* w)
+{
+    bsf_assets_t* assets = &bsf->assets;
+    const float t0 = gs_platform_elapsed_time();
+    gs_snprintfc(PATH, 256, "%s/%s", assets->asset_dir, w->path);
+    switch (w->type)
+    {
+        case BSF_ASSET_WATCH_TEXTURE:
+        {
+            gs_graphics_texture_desc_t desc = w->desc;
+            void* data = NULL;
+            gs_util_load_texture_data_from_file(PATH, &desc.width, &desc.height, &(uint32_t){0}, &data, false);
+            if (!data) return;
+            desc.data[0] = data;
+            if (desc.num_mips == BSF_TEXTURE_MIPS_FULL) {
+                desc.num_mips = bsf_assets_mip_count(desc.width, desc.height);
+            }
+            gs_gfxt_texture_t* tex = gs_hash_table_getp(assets->textures, w->key);
+            const gs_gfxt_texture_t old = *tex;
+            *tex = gs_graphics_texture_create(&desc);
+            gs_free(data);
+            bsf_assets_materials_rebind(assets, old.id, tex->id);
+
+            // Entries that never loaded still share tex.default
+            if (old.id != assets->hndl.tex_default->id) {
+                bsf_assets_retire(assets, (bsf_asset_retired_t){.type = w->type, .texture = old});
+            }
+        } break;
+
+        case BSF_ASSET_WATCH_MESH:
+        {
+            const gs_gfxt_pipeline_t* pip = w->pip;
+            const gs_gfxt_mesh_t loaded = gs_gfxt_mesh_load_from_file(PATH, &(gs_gfxt_mesh_import_options_t){
+                .layout = pip->mesh_layout,
+                .size = gs_dyn_array_size(pip->mesh_layout) * sizeof(gs_gfxt_mesh_layout_t),
+                .index_buffer_element_size = pip->desc.raster.index_buffer_element_size
+            });
+            if (gs_dyn_array_empty(loaded.primitives)) {
+                gs_println("Warning: BSF::Keeping previous mesh, unable to load %s", w->path);
+                return;
+            }
+            gs_gfxt_mesh_t* mesh = gs_hash_table_getp(assets->meshes, w->key);
+            const gs_gfxt_mesh_t old = *mesh;
+            *mesh = loaded;
+
+            // Renderables created before this keep the bounds they were created with
+            *gs_hash_table_getp(assets->mesh_bounds, (uint64_t)(uintptr_t)mesh) = bsf_graphics_mesh_bounds_from_file(PATH);
+
+            // Placeholder buffers are shared with other entries
+            const uint64_t pkey = (uint64_t)(uintptr_t)pip;
+            const bool32 placeholder = gs_hash_table_exists(assets->stream.placeholders, pkey) &&
+                gs_hash_table_getp(assets->stream.placeholders, pkey)->primitives == old.primitives;
+            if (!placeholder) {
+                bsf_assets_retire(assets, (bsf_asset_retired_t){.type = w->type, .mesh = old});
+            }
+        } break;
+
+        case BSF_ASSET_WATCH_PIPELINE:
+        {
+            // Materials of a base pipeline bind through its instanced twin, so twins reload together or not at all
+            gs_gfxt_pipeline_t* dst[2] = {gs_hash_table_getp(assets->pipelines, w->key), NULL};
+            bsf_asset_watch_t* watches[2] = {w, NULL};
+            const bsf_render_instancing_t* inst = &bsf->scene.instancing;
+            for (uint32_t i = 0; i < inst->count; ++i) {
+                if (inst->pipelines[i] == dst[0]) dst[1] = inst->instanced[i];
+                if (inst->instanced[i] == dst[0]) dst[1] = (gs_gfxt_pipeline_t*)inst->pipelines[i];
+            }
+            for (uint32_t i = 0; dst[1] && i < gs_dyn_array_size(assets->reload.watches); ++i) {
+                bsf_asset_watch_t* tw = &assets->reload.watches[i];
+                if (tw->type == BSF_ASSET_WATCH_PIPELINE && gs_hash_table_getp(assets->pipelines, tw->key) == dst[1]) watches[1] = tw;
+            }
+            const uint32_t count = watches[1] ? 2 : 1;
+
+            // A half edited .sf fails to parse or compile, the old pipelines stay until a good save
+            gs_gfxt_pipeline_t loaded[2] = {0};
+            bool32 valid = true;
+            for (uint32_t i = 0; i < count; ++i) 
+            {
+                bool32 cached = false;
+                gs_snprintfc(TMP, 256, "%s/%s", assets->asset_dir, watches[i]->path);
+                loaded[i] = bsf_assets_pipeline_load(TMP, &cached);
+                const bool32 ok = loaded[i].hndl.id && loaded[i].desc.layout.size == dst[i]->desc.layout.size && 
+                    !gs_dyn_array_empty(loaded[i].ublock.uniforms);
+                if (!ok) gs_println("Warning: BSF::Keeping previous pipeline, unable to load %s", watches[i]->path);
+                valid = valid && ok;
+            }
+            if (valid && count == 2 && !bsf_graphics_pipeline_ublock_equal(&loaded[0], &loaded[1])) {
+                gs_println("Warning: BSF::Keeping previous pipelines, uniforms of %s and %s differ", watches[0]->path, watches[1]->path);
+                valid = false;
+            }
+            if (!valid) {
+                for (uint32_t i = 0; i < count; ++i) {
+                    if (loaded[i].hndl.id) gs_gfxt_pipeline_destroy(&loaded[i]);
+                }
+                return;
+            }
+
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                gs_gfxt_pipeline_t* pip = dst[i];
+                const gs_gfxt_pipeline_t old = *pip;
+                *pip = loaded[i];
+                watches[i]->dirty = false;
+
+                for (uint32_t t = 0; t < inst->count; ++t) {
+                    if (inst->instanced[t] == pip) bsf_graphics_pipeline_make_instanced(pip);
+                }
+
+                for (
+                    gs_hash_table_iter it = gs_hash_table_iter_new(assets->materials);
+                    gs_hash_table_iter_valid(assets->materials, it);
+                    gs_hash_table_iter_advance(assets->materials, it)
+                )
+                {
+                    gs_gfxt_material_t* mat = gs_hash_table_iter_getp(assets->materials, it);
+                    if (gs_gfxt_material_get_pipeline(mat) == pip) bsf_assets_material_rebuild(mat, &old);
+                }
+
+                const uint32_t slots = bsf_assets_uniform_slots_index(assets, pip);
+                if (slots != UINT32_MAX) bsf_assets_uniform_slots_fill(&assets->uniform_slots[slots]);
+                bsf_assets_retire(assets, (bsf_asset_retired_t){.type = w->type, .pipeline = old});
+            }
+            if (count == 2) gs_println("BSF::Reloaded %s with %s", watches[1]->path, w->path);
+        } break;
+
+        case BSF_ASSET_WATCH_ROOM_TEMPLATE:
+        {
+            // Picked up by the next room load
+            bsf_room_template_t* rt = gs_hash_table_getp(assets->room_templates, w->key);
+            gs_slot_array_free(rt->brushes);
+            rt->brushes = NULL;
+            bsf_assets_room_template_read(PATH, rt);
+        } break;
+
+        case BSF_ASSET_WATCH_STYLE_SHEET:
+        {
+            gs_gui_style_sheet_t* ss = gs_hash_table_getp(assets->style_sheets, w->key);
+            gs_gui_style_sheet_destroy(&bsf->gs.gui, ss);
+            *ss = gs_gui_style_sheet_load_from_file(&bsf->gs.gui, PATH);
+        } break;
+    }
+    gs_println("BSF::Reloaded %s: %.2fms", w->path, gs_platform_elapsed_time() - t0);
+}
+
+GS_API_DECL void bsf_assets_reload(bsf_t* bsf)
+{
+    bsf_assets_t* assets = &bsf->assets;
+    bsf_asset_reload_t* reload = &assets->reload;
+
+    for (uint32_t i = 0; i < gs_dyn_array_size(reload->retired);)
+    {
+        bsf_asset_retired_t* r = &reload->retired[i];
+        if (r->frames) {
+            r->frames--;
+            ++i;
+            continue;
+        }
+        bsf_assets_retired_destroy(r);
+        *r = gs_dyn_array_back(reload->retired);
+        gs_dyn_array_pop(reload->retired);
+    }
+
+#ifdef BSF_ASSET_WATCH
+    // Drain pending events, several writes to a file between frames reload it once
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t len = 0;
+    while (reload->fd >= 0 && (len = read(reload->fd, buf, sizeof(buf))) > 0)
+    {
+        for (char* p = buf; p < buf + len;)
+        {
+            const struct inotify_event* ev = (const struct inotify_event*)p;
+            p += sizeof(struct inotify_event) + ev->len;
+            if (!ev->len) continue;
+
+            const char* dir = NULL;
+            for (uint32_t d = 0; d < reload->dir_count; ++d) {
+                if (reload->wds[d] == ev->wd) dir = reload->dirs[d];
+            }
+            if (!dir) continue;
+
+            gs_snprintfc(TMP, 256, "%s/%s", dir, ev->name);
+            for (uint32_t i = 0; i < gs_dyn_array_size(reload->watches); ++i)
+            {
+                bsf_asset_watch_t* w = &reload->watches[i];
+                if (!strcmp(w->path, TMP)) w->dirty = true;
+
+                // Gltf buffers sit next to the gltf under the same name (tools/mesh_simplify.py)
+                const char* ext = strrchr(w->path, '.');
+                if (w->type == BSF_ASSET_WATCH_MESH && ext && !strncmp(w->path, TMP, ext - w->path) && !strcmp(TMP + (ext - w->path), ".bin")) {
+                    w->dirty = true;
+                }
+            }
+        }
+    }
+#endif
+
+    // Streamed loads land in the same entries, wait for them
+    if (!bsf_assets_loaded(assets)) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < gs_dyn_array_size(reload->watches); ++i)
+    {
+        bsf_asset_watch_t* w = &reload->watches[i];
+        if (!w->dirty) continue;
+
+        // The editor owns room templates while open, its saves are already in memory
+        if (w->type == BSF_ASSET_WATCH_ROOM_TEMPLATE && bsf->state == BSF_STATE_EDITOR) continue;
+
+        w->dirty = false;
+        bsf_assets_reload_watch(bsf, w);
+    }
+}
+
+GS_API_DECL void bsf_assets_reload_free(bsf_assets_t* assets)
+{
+    bsf_asset_reload_t* reload = &assets->reload;
+    for (uint32_t i = 0; i < gs_dyn_array_size(reload->retired); ++i) {
+        bsf_assets_retired_destroy(&reload->retired[i]);
+    }
+    gs_dyn_array_free(reload->retired);
+    gs_dyn_array_free(reload->watches);
+#ifdef BSF_ASSET_WATCH
+    if (reload->fd >= 0) close(reload->fd);
+#endif
+    reload->fd = -1;
+}
+
+GS_API_DECL void bsf_dbg_reload_ss(struct bsf_t* bsf)
+{
+    // Files are watched where inotify is available, this covers the rest
+    for (uint32_t i = 0; i < gs_dyn_array_size(bsf->assets.reload.watches); ++i) {
+        bsf_asset_watch_t* w = &bsf->assets.reload.watches[i];
+        if (w->type == BSF_ASSET_WATCH_STYLE_SHEET) w->dirty = true;
+    }
+}
+
+//=== BSF Graphics ===//
+
+GS_API_DECL uint32_t bsf_graphics_scene_renderable_create(bsf_graphics_scene_t* scene, const bsf_renderable_desc_t* desc)
+{
+    bsf_t* bsf = gs_user_data(bsf_t);
+    bsf_renderable_t rend = *desc;
+    if (rend.tint.w == 0.f) {
+        rend.tint = gs_v4s(1.f);
+    }
+    const uint64_t mesh_key = (uint64_t)(uintptr_t)rend.mesh;
+    if (rend.bounds.w == 0.f) {
+        rend.bounds = gs_hash_table_exists(bsf->assets.mesh_bounds, mesh_key) ? 
+            gs_hash_table_get(bsf->assets.mesh_bounds, mesh_key) : gs_v4(0.f, 0.f, 0.f, FLT_MAX);
+    }
+    if (!rend.lod && gs_hash_table_exists(bsf->assets.mesh_lods, mesh_key)) {
+        rend.lod = gs_hash_table_getp(bsf->assets.mesh_lods, mesh_key);
+    }
+    return gs_slot_array_insert(scene->renderables, rend);
+}
+
+GS_API_DECL void bsf_graphics_scene_renderable_destroy(bsf_graphics_scene_t* scene, uint32_t hndl)
+{
+    if (gs_slot_array_handle_valid(scene->renderables, hndl))
+    {
+        gs_slot_array_erase(scene->renderables, hndl);
+    }
+}
+
+static uint16_t bsf_render_queue_id(const void** ids, uint32_t* count, const void* ptr)
+{
+    // Only a handful of distinct pipelines/materials/meshes per frame, linear scan beats hashing
+    for (uint32_t i = 0; i < *count; ++i) {
+        if (ids[i] == ptr) return (uint16_t)i;
+    }
+    gs_assert(*count < BSF_RENDER_QUEUE_MAX_IDS);
+    ids[*count] = ptr;
+    return (uint16_t)(*count)++;
+}
+
+GS_API_DECL void bsf_render_queue_clear(bsf_render_queue_t* queue)
+{
+    queue->count = 0;
+    queue->pipeline_count = 0;
+    queue->material_count = 0;
+    queue->mesh_count = 0;
+    memset(&queue->stats, 0, sizeof(queue->stats));
+}
+
+GS_API_DECL void bsf_render_queue_push(bsf_render_queue_t* queue, bsf_renderable_t* rend, float depth)
+{
+    if (queue->count == queue->capacity) {
+        queue->capacity = queue->capacity ? queue->capacity * 2 : 256;
+        queue->items = gs_realloc(queue->items, queue->capacity * sizeof(bsf_render_item_t));
+        queue->tmp = gs_realloc(queue->tmp, queue->capacity * sizeof(bsf_render_item_t));
+    }
+
+    const gs_gfxt_pipeline_t* pip = GS_GFXT_RAW_DATA(&rend->material->desc.pip_func, gs_gfxt_pipeline_t);
+    const uint64_t pid = bsf_render_queue_id(queue->pipelines, &queue->pipeline_count, pip);
+    const uint64_t mid = bsf_render_queue_id(queue->materials, &queue->material_count, rend->material);
+    const uint64_t eid = bsf_render_queue_id(queue->meshes, &queue->mesh_count, rend->mesh);
+    const uint64_t d = (uint64_t)(gs_clamp(depth, 0.f, 1.f) * (float)UINT16_MAX);
+
+    queue->items[queue->count++] = (bsf_render_item_t) {
+        .key = (pid << BSF_RENDER_KEY_PIPELINE_SHIFT) | (mid << BSF_RENDER_KEY_MATERIAL_SHIFT) | (eid << BSF_RENDER_KEY_MESH_SHIFT) | d,
+        .rend = rend
+    };
+}
+
+GS_API_DECL void bsf_render_queue_sort(bsf_render_queue_t* queue)
+{
+    if (queue->count < 2) return;
+
+    // LSD radix sort, 8 bits per pass. Passes where every key shares the byte are skipped
+    // (ids are small, so most of the upper bytes are constant).
+    bsf_render_item_t* src = queue->items;
+    bsf_render_item_t* dst = queue->tmp;
+    for (uint32_t shift = 0; shift < 64; shift += 8)
+    {
+        uint32_t hist[256] = {0};
+        for (uint32_t i = 0; i < queue->count; ++i) {
+            hist[(src[i].key >> shift) & 0xFF]++;
+        }
+        if (hist[(src[0].key >> shift) & 0xFF] == queue->count) continue;
+
+        uint32_t sum = 0;
+        for (uint32_t b = 0; b < 256; ++b) {
+            const uint32_t c = hist[b];
+            hist[b] = sum;
+            sum += c;
+        }
+        for (uint32_t i = 0; i < queue->count; ++i) {
+            dst[hist[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+
+        bsf_render_item_t* t = src;
+        src = dst;
+        dst = t;
+    }
+    queue->items = src;
+    queue->tmp = dst;
+}
+
+GS_API_DECL void bsf_render_queue_free(bsf_render_queue_t* queue)
+{
+    gs_free(queue->items);
+    gs_free(queue->tmp);
+    memset(queue, 0, sizeof(bsf_render_queue_t));
+}
+
+GS_API_DECL void bsf_render_cull_clear(bsf_render_cull_t* cull, const gs_mat4* vp)
+{
+    cull->count = 0;
+    memset(&cull->stats, 0, sizeof(cull->stats));
+
+    // Planes from the view projection rows (left, right, bottom, top, near, far), normalized
+    const float* m = vp->elements;
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        const uint32_t row = i / 2;
+        const float s = (i % 2) ? -1.f : 1.f;
+        gs_vec4 p = gs_v4(
+            m[3] + s * m[row],
+            m[7] + s * m[4 + row],
+            m[11] + s * m[8 + row],
+            m[15] + s * m[12 + row]
+        );
+        const float len = gs_vec3_len(gs_v3(p.x, p.y, p.z));
+        cull->planes[i] = gs_vec4_scale(p, 1.f / len);
+    }
+}
+
+GS_API_DECL void bsf_render_cull_push(bsf_render_cull_t* cull, bsf_renderable_t* rend)
+{
+    if (cull->count == cull->capacity)
+    {
+        cull->capacity = cull->capacity ? cull->capacity * 2 : 256;
+        cull->x = gs_realloc(cull->x, cull->capacity * sizeof(float));
+        cull->y = gs_realloc(cull->y, cull->capacity * sizeof(float));
+        cull->z = gs_realloc(cull->z, cull->capacity * sizeof(float));
+        cull->r = gs_realloc(cull->r, cull->capacity * sizeof(float));
+        cull->rends = gs_realloc(cull->rends, cull->capacity * sizeof(bsf_renderable_t*));
+        cull->visible = gs_realloc(cull->visible, cull->capacity);
+    }
+
+    // Bounds to world space, radius scaled by largest axis scale of model
+    const float* m = rend->model.elements;
+    const gs_vec4 b = rend->bounds;
+    const float sx = m[0] * m[0] + m[1] * m[1] + m[2] * m[2];
+    const float sy = m[4] * m[4] + m[5] * m[5] + m[6] * m[6];
+    const float sz = m[8] * m[8] + m[9] * m[9] + m[10] * m[10];
+    const uint32_t i = cull->count++;
+    cull->x[i] = m[0] * b.x + m[4] * b.y + m[8] * b.z + m[12];
+    cull->y[i] = m[1] * b.x + m[5] * b.y + m[9] * b.z + m[13];
+    cull->z[i] = m[2] * b.x + m[6] * b.y + m[10] * b.z + m[14];
+    cull->r[i] = b.w * sqrtf(gs_max(sx, gs_max(sy, sz)));
+    cull->rends[i] = rend;
+}
+
+GS_API_DECL void bsf_render_cull_test(bsf_render_cull_t* cull)
+{
+    uint8_t* visible = cull->visible;
+    uint32_t i = 0;
+
+#ifdef BSF_SIMD_SSE
+    // Sphere is outside if it's fully behind any plane: dot(n, c) + d < -r
+    for (; i + 4 <= cull->count; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(&cull->x[i]);
+        const __m128 y = _mm_loadu_ps(&cull->y[i]);
+        const __m128 z = _mm_loadu_ps(&cull->z[i]);
+        const __m128 nr = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&cull->r[i]));
+        __m128 inside = _mm_cmpeq_ps(nr, nr);
+        for (uint32_t p = 0; p < 6; ++p)
+        {
+            const gs_vec4 pl = cull->planes[p];
+            __m128 d = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(pl.x)), _mm_set1_ps(pl.w));
+            d = _mm_add_ps(d, _mm_mul_ps(y, _mm_set1_ps(pl.y)));
+            d = _mm_add_ps(d, _mm_mul_ps(z, _mm_set1_ps(pl.z)));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, nr));
+        }
+        const int32_t mask = _mm_movemask_ps(inside);
+        for (uint32_t j = 0; j < 4; ++j) {
+            visible[i + j] = (mask >> j) & 1;
+        }
+    }
+#endif
+
+    for (; i < cull->count; ++i)
+    {
+        visible[i] = 1;
+        for (uint32_t p = 0; p < 6; ++p)
+        {
+            const gs_vec4 pl = cull->planes[p];
+            if (pl.x * cull->x[i] + pl.y * cull->y[i] + pl.z * cull->z[i] + pl.w < -cull->r[i]) {
+                visible[i] = 0;
+                break;
+            }
+        }
+    }
+
+    for (i = 0; i < cull->count; ++i) {
+        if (visible[i]) cull->stats.visible++;
+        else cull->stats.culled++;
+    }
+}
+
+GS_API_DECL void bsf_render_cull_free(bsf_render_cull_t* cull)
+{
+    gs_free(cull->x);
+    gs_free(cull->y);
+    gs_free(cull->z);
+    gs_free(cull->r);
+    gs_free(cull->rends);
+    gs_free(cull->visible);
+    memset(cull, 0, sizeof(bsf_render_cull_t));
+}
+
+static size_t bsf_graphics_vertex_attribute_size(gs_graphics_vertex_attribute_type format)
+{
+    switch (format)
+    {
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_FLOAT4: return 4 * sizeof(float);
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_FLOAT3: return 3 * sizeof(float);
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_FLOAT2: return 2 * sizeof(float);
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_FLOAT:  return sizeof(float);
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_UINT4:  return 4 * sizeof(uint32_t);
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_UINT3:  return 3 * sizeof(uint32_t);
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_UINT2:  return 2 * sizeof(uint32_t);
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_UINT:   return sizeof(uint32_t);
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE4:  return 4;
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE3:  return 3;
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE2:  return 2;
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE:   return 1;
+        default: return 0;
+    }
+}
+
+GS_API_DECL void bsf_graphics_pipeline_make_instanced(gs_gfxt_pipeline_t* pip)
+{
+    // .sf has no syntax for per instance stepping, so recreate the pipeline with the trailing 
+    // instance attributes read from buffer 1 (divisor 1) and mesh attributes packed in buffer 0
+    gs_graphics_pipeline_desc_t desc = pip->desc;
+    const uint32_t cnt = (uint32_t)(desc.layout.size / sizeof(gs_graphics_vertex_attribute_desc_t));
+    gs_assert(cnt > BSF_RENDER_INSTANCE_ATTR_COUNT);
+    const uint32_t base = cnt - BSF_RENDER_INSTANCE_ATTR_COUNT;
+
+    gs_graphics_vertex_attribute_desc_t* attrs = gs_malloc(desc.layout.size);
+    memcpy(attrs, desc.layout.attrs, desc.layout.size);
+
+    size_t stride = 0;
+    for (uint32_t i = 0; i < base; ++i) {
+        stride += bsf_graphics_vertex_attribute_size(attrs[i].format);
+    }
+
+    size_t offset = 0;
+    for (uint32_t i = 0; i < base; ++i) {
+        attrs[i].stride = stride;
+        attrs[i].offset = offset;
+        attrs[i].buffer_idx = 0;
+        offset += bsf_graphics_vertex_attribute_size(attrs[i].format);
+    }
+
+    for (uint32_t i = base; i < cnt; ++i) {
+        attrs[i].stride = sizeof(bsf_render_instance_t);
+        attrs[i].offset = (i - base) * sizeof(gs_vec4);
+        attrs[i].divisor = 1;
+        attrs[i].buffer_idx = 1;
+    }
+
+    // Replace the loaded attribute array, the pipeline owns its copy
+    desc.layout.attrs = attrs;
+    gs_graphics_pipeline_destroy(pip->hndl);
+    pip->hndl = gs_graphics_pipeline_create(&desc);
+    if (pip->desc.layout.attrs) gs_free(pip->desc.layout.attrs);
+    pip->desc = desc;
+}
+
+GS_API_DECL void bsf_render_instancing_register(bsf_render_instancing_t* inst, const gs_gfxt_pipeline_t* pip, gs_gfxt_pipeline_t* instanced)
+{
+    gs_assert(inst->count < BSF_RENDER_INSTANCED_PIPELINE_MAX);
+    inst->pipelines[inst->count] = pip;
+    inst->instanced[inst->count] = instanced;
+    inst->count++;
+}
+
+GS_API_DECL gs_gfxt_pipeline_t* bsf_render_instancing_get(const bsf_render_instancing_t* inst, const gs_gfxt_pipeline_t* pip)
+{
+    for (uint32_t i = 0; i < inst->count; ++i) {
+        if (inst->pipelines[i] == pip) return inst->instanced[i];
+    }
+    return NULL;
+}
+
+GS_API_DECL void bsf_render_instancing_reserve(bsf_render_instancing_t* inst, uint32_t count)
+{
+    // Created up front, render thread only records updates into existing buffers
+    while (gs_dyn_array_size(inst->vbos) < count) {
+        gs_dyn_array_push(inst->vbos, gs_graphics_vertex_buffer_create(&(gs_graphics_vertex_buffer_desc_t){
+            .data = NULL,
+            .size = 0,
+            .usage = GS_GRAPHICS_BUFFER_USAGE_DYNAMIC
+        }));
+    }
+}
+
+GS_API_DECL void bsf_render_instancing_free(bsf_render_instancing_t* inst)
+{
+    for (uint32_t i = 0; i < gs_dyn_array_size(inst->vbos); ++i) {
+        gs_graphics_vertex_buffer_destroy(inst->vbos[i]);
+    }
+    gs_dyn_array_free(inst->vbos);
+    gs_free(inst->data);
+    memset(inst, 0, sizeof(bsf_render_instancing_t));
+}
+
+static void bsf_graphics_draw_instances(gs_command_buffer_t* cb, bsf_graphics_scene_t* scene, uint32_t group, gs_gfxt_material_t* mat, 
+        gs_gfxt_mesh_t* mesh, const bsf_render_instance_t* data, uint32_t count, gs_gfxt_pipeline_t* pip, const gs_gfxt_texture_t* tex)
+{
+    bsf_t* bsf = gs_user_data(bsf_t);
+    bsf_render_instancing_t* inst = &scene->instancing;
+    bsf_render_queue_t* queue = &scene->queue;
+
+    gs_assert(group < gs_dyn_array_size(inst->vbos));
+    gs_graphics_vertex_buffer_request_update(cb, inst->vbos[group], &(gs_graphics_vertex_buffer_desc_t){
+        .data = (void*)data,
+        .size = count * sizeof(bsf_render_instance_t),
+        .usage = GS_GRAPHICS_BUFFER_USAGE_DYNAMIC
+    });
+
+    // Uniform layout of the instanced twin matches the base pipeline, so the material binds through it as is.
+    // Bound through a copy, main thread may be reading the material's pipeline at the same time.
+    if (tex) {
+        BSF_MATERIAL_SET_UNIFORM(&bsf->assets, mat, u_tex, tex);
+    }
+    gs_gfxt_material_t imat = *mat;
+    imat.desc.pip_func.hndl = pip;
+    gs_gfxt_material_bind(cb, &imat);
+    gs_gfxt_material_bind_uniforms(cb, &imat);
+    bsf_graphics_camera_bind(cb, scene);
+    queue->stats.pipeline_binds++;
+
+    for (uint32_t p = 0; p < gs_dyn_array_size(mesh->primitives); ++p)
+    {
+        gs_gfxt_mesh_primitive_t* prim = &mesh->primitives[p];
+        gs_graphics_bind_vertex_buffer_desc_t vbos[] = {
+            {.buffer = prim->vbo},
+            {.buffer = inst->vbos[group]}
+        };
+        gs_graphics_bind_desc_t binds = {
+            .vertex_buffers = {.desc = vbos, .size = sizeof(vbos)},
+            .index_buffers = {.desc = &(gs_graphics_bind_index_buffer_desc_t){.buffer = prim->indices}}
+        };
+        gs_graphics_apply_bindings(cb, &binds);
+        gs_graphics_draw(cb, &(gs_graphics_draw_desc_t){.start = 0, .count = prim->count, .instances = count});
+        queue->stats.mesh_binds++;
+        queue->stats.draws++;
+    }
+    queue->stats.instances += count;
+}
+
+static void bsf_graphics_draw_instanced(gs_command_buffer_t* cb, bsf_graphics_scene_t* scene, uint32_t group, 
+        const bsf_render_item_t* items, uint32_t count, gs_gfxt_pipeline_t* pip, const gs_gfxt_texture_t* tex)
+{
+    bsf_render_instancing_t* inst = &scene->instancing;
+
+    // Stage instance data
+    if (count > inst->capacity) {
+        inst->capacity = gs_max(count, inst->capacity * 2);
+        inst->data = gs_realloc(inst->data, inst->capacity * sizeof(bsf_render_instance_t));
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        inst->data[i] = (bsf_render_instance_t){
+            .model = items[i].rend->model, 
+            .tint = items[i].rend->tint, 
+            .flash = items[i].rend->flash
+        };
+    }
+
+    bsf_graphics_draw_instances(cb, scene, group, items[0].rend->material, items[0].rend->mesh, inst->data, count, pip, tex);
+}
+
+static void bsf_shape_push_quad(gs_dyn_array(bsf_shape_vert_t)* verts, gs_dyn_array(uint16_t)* indices, 
+        gs_vec3 p0, gs_vec3 p1, gs_vec3 p2, gs_vec3 p3)
+{
+    const uint16_t base = (uint16_t)gs_dyn_array_size(*verts);
+    gs_dyn_array_push(*verts, ((bsf_shape_vert_t){.position = p0, .uv = gs_v2(0.f, 0.f), .color = GS_COLOR_WHITE}));
+    gs_dyn_array_push(*verts, ((bsf_shape_vert_t){.position = p1, .uv = gs_v2(1.f, 0.f), .color = GS_COLOR_WHITE}));
+    gs_dyn_array_push(*verts, ((bsf_shape_vert_t){.position = p2, .uv = gs_v2(1.f, 1.f), .color = GS_COLOR_WHITE}));
+    gs_dyn_array_push(*verts, ((bsf_shape_vert_t){.position = p3, .uv = gs_v2(0.f, 1.f), .color = GS_COLOR_WHITE}));
+    const uint16_t quad[] = {0, 1, 2, 0, 2, 3};
+    for (uint32_t i = 0; i < 6; ++i) {
+        gs_dyn_array_push(*indices, base + quad[i]);
+    }
+}
+
+static void bsf_shape_push_box(gs_dyn_array(bsf_shape_vert_t)* verts, gs_dyn_array(uint16_t)* indices, gs_vec3 c, gs_vec3 he)
+{
+    // One quad per face so each face gets full uvs, same as gsi_box
+    for (uint32_t f = 0; f < 6; ++f)
+    {
+        const uint32_t a = f / 2, u = (a + 1) % 3, v = (a + 2) % 3;
+        const float n = (f % 2) ? 1.f : -1.f;
+        gs_vec3 p[4];
+        for (uint32_t k = 0; k < 4; ++k) {
+            const float su = (k == 1 || k == 2) ? 1.f : -1.f;
+            const float sv = (k >= 2) ? 1.f : -1.f;
+            p[k] = c;
+            p[k].xyz[a] += n * he.xyz[a];
+            p[k].xyz[u] += su * he.xyz[u];
+            p[k].xyz[v] += sv * he.xyz[v];
+        }
+        bsf_shape_push_quad(verts, indices, p[0], p[1], p[2], p[3]);
+    }
+}
+
+static void bsf_shape_push_cylinder(gs_dyn_array(bsf_shape_vert_t)* verts, gs_dyn_array(uint16_t)* indices, 
+        float r_top, float r_bottom, float height, uint32_t sides)
+{
+    // Base at origin, top at height (cone when r_top is zero), same as gsi_cylinder/gsi_cone
+    for (uint32_t i = 0; i < sides; ++i)
+    {
+        const float a0 = (float)i / (float)sides * 2.f * GS_PI;
+        const float a1 = (float)(i + 1) / (float)sides * 2.f * GS_PI;
+        const gs_vec3 b0 = gs_v3(sinf(a0) * r_bottom, 0.f, cosf(a0) * r_bottom);
+        const gs_vec3 b1 = gs_v3(sinf(a1) * r_bottom, 0.f, cosf(a1) * r_bottom);
+        const gs_vec3 t0 = gs_v3(sinf(a0) * r_top, height, cosf(a0) * r_top);
+        const gs_vec3 t1 = gs_v3(sinf(a1) * r_top, height, cosf(a1) * r_top);
+        bsf_shape_push_quad(verts, indices, b0, b1, t1, t0);
+
+        // Caps as degenerate quads to the center
+        bsf_shape_push_quad(verts, indices, gs_v3(0.f, 0.f, 0.f), b1, b0, b0);
+        if (r_top > 0.f) {
+            bsf_shape_push_quad(verts, indices, gs_v3(0.f, height, 0.f), t0, t1, t1);
+        }
+    }
+}
+
+static void bsf_shape_push_sphere(gs_dyn_array(bsf_shape_vert_t)* verts, gs_dyn_array(uint16_t)* indices, float r, uint32_t rings, uint32_t sectors)
+{
+    const uint16_t base = (uint16_t)gs_dyn_array_size(*verts);
+    for (uint32_t i = 0; i <= rings; ++i)
+    {
+        const float phi = (float)i / (float)rings * GS_PI;
+        for (uint32_t j = 0; j <= sectors; ++j)
+        {
+            const float theta = (float)j / (float)sectors * 2.f * GS_PI;
+            gs_dyn_array_push(*verts, ((bsf_shape_vert_t){
+                .position = gs_v3(r * sinf(phi) * cosf(theta), r * cosf(phi), r * sinf(phi) * sinf(theta)),
+                .uv = gs_v2((float)j / (float)sectors, (float)i / (float)rings),
+                .color = GS_COLOR_WHITE
+            }));
+        }
+    }
+
+    for (uint32_t i = 0; i < rings; ++i)
+    {
+        for (uint32_t j = 0; j < sectors; ++j)
+        {
+            const uint16_t a = base + i * (sectors + 1) + j;
+            const uint16_t b = a + sectors + 1;
+            const uint16_t tri[] = {a, b, a + 1, a + 1, b, b + 1};
+            for (uint32_t k = 0; k < 6; ++k) {
+                gs_dyn_array_push(*indices, tri[k]);
+            }
+        }
+    }
+}
+
+GS_API_DECL void bsf_graphics_shapes_create(bsf_graphics_scene_t* scene)
+{
+    for (uint32_t s = 0; s < BSF_SHAPE_ROOM; ++s)
+    {
+        gs_dyn_array(bsf_shape_vert_t) verts = NULL;
+        gs_dyn_array(uint16_t) indices = NULL;
 
-    for (uint32_t i = 0; pipelines[i].key; ++i)
+        // Same unit extents the immediate system used with gsi
+        switch (s)
+        {
+            case BSF_SHAPE_BOX:      bsf_shape_push_box(&verts, &indices, gs_v3s(0.f), gs_v3s(0.5f)); break;
+            case BSF_SHAPE_SPHERE:   bsf_shape_push_sphere(&verts, &indices, 0.5f, 16, 16); break;
+            case BSF_SHAPE_CONE:     bsf_shape_push_cylinder(&verts, &indices, 0.f, 0.5f, 1.f, 16); break;
+            case BSF_SHAPE_CYLINDER: bsf_shape_push_cylinder(&verts, &indices, 0.5f, 0.5f, 1.f, 16); break;
+            case BSF_SHAPE_RECT:
+            {
+                bsf_shape_push_quad(&verts, &indices, gs_v3(-0.5f, -0.5f, 0.f), gs_v3(0.5f, -0.5f, 0.f), 
+                    gs_v3(0.5f, 0.5f, 0.f), gs_v3(-0.5f, 0.5f, 0.f));
+            } break;
+            case BSF_SHAPE_CROSS:
+            {
+                bsf_shape_push_box(&verts, &indices, gs_v3s(0.f), gs_v3(0.1f, 0.5f, 0.1f));
+                bsf_shape_push_box(&verts, &indices, gs_v3s(0.f), gs_v3(0.5f, 0.1f, 0.1f));
+            } break;
+        }
+
+        gs_gfxt_mesh_primitive_t prim = {
+            .vbo = gs_graphics_vertex_buffer_create(&(gs_graphics_vertex_buffer_desc_t){
+                .data = verts,
+                .size = gs_dyn_array_size(verts) * sizeof(bsf_shape_vert_t)
+            }),
+            .indices = gs_graphics_index_buffer_create(&(gs_graphics_index_buffer_desc_t){
+                .data = indices,
+                .size = gs_dyn_array_size(indices) * sizeof(uint16_t)
+            }),
+            .count = gs_dyn_array_size(indices)
+        };
+        gs_dyn_array_push(scene->shapes[s].primitives, prim);
+
+        gs_dyn_array_free(verts);
+        gs_dyn_array_free(indices);
+    }
+}
+
+GS_API_DECL void bsf_graphics_shapes_free(bsf_graphics_scene_t* scene)
+{
+    for (uint32_t s = 0; s < BSF_SHAPE_ROOM; ++s)
     {
-        gs_snprintfc(TMP, 256, "%s/%s", assets->asset_dir, pipelines[i].path);
-        gs_hash_table_insert(assets->pipelines, gs_hash_str64(pipelines[i].key), gs_gfxt_pipeline_load_from_file(TMP));
+        for (uint32_t p = 0; p < gs_dyn_array_size(scene->shapes[s].primitives); ++p) {
+            gs_graphics_vertex_buffer_destroy(scene->shapes[s].primitives[p].vbo);
+            gs_graphics_index_buffer_destroy(scene->shapes[s].primitives[p].indices);
+        }
+        gs_dyn_array_free(scene->shapes[s].primitives);
     }
+}
 
-    struct {const char* key; const char* path; const char* pip;} meshes[] = {
-        {.key = "mesh.ship", .path = "meshes/ship.gltf", .pip = "pip.simple"}, 
-        {.key = "mesh.slave", .path = "meshes/slave.gltf", .pip = "pip.simple"}, 
-        {.key = "mesh.arwing", .path = "meshes/arwing.gltf", .pip = "pip.simple"}, 
-        {.key = "mesh.arwing64", .path = "meshes/arwing64.gltf", .pip = "pip.simple"}, 
-        {.key = "mesh.bandit", .path = "meshes/bandit.gltf", .pip = "pip.simple"}, 
-        {.key = "mesh.turret", .path = "meshes/turret.gltf", .pip = "pip.simple"}, 
-        {.key = "mesh.laser_player", .path = "meshes/laser_player.gltf", .pip = "pip.color"}, 
-        {.key = "mesh.brain", .path = "meshes/brain.gltf", .pip = "pip.simple"}, 
-        {NULL} 
-    };
+GS_API_DECL gs_gfxt_mesh_t bsf_graphics_mesh_placeholder(const gs_gfxt_pipeline_t* pip)
+{
+    gs_dyn_array(bsf_shape_vert_t) verts = NULL;
+    gs_dyn_array(uint16_t) indices = NULL;
+    bsf_shape_push_box(&verts, &indices, gs_v3s(0.f), gs_v3s(0.5f));
 
-    for (uint32_t i = 0; meshes[i].key; ++i)
+    // Interleaved the way gs_gfxt_mesh_load_from_file lays out each attribute, defaults for anything a box lacks
+    gs_byte_buffer_t vb = gs_byte_buffer_new();
+    for (uint32_t v = 0; v < gs_dyn_array_size(verts); ++v)
     {
-        gs_snprintfc(TMP, 256, "%s/%s", assets->asset_dir, meshes[i].path);
-        gs_gfxt_pipeline_t* pip = gs_hash_table_getp(assets->pipelines, gs_hash_str64(meshes[i].pip));
-        gs_hash_table_insert(assets->meshes, gs_hash_str64(meshes[i].key), gs_gfxt_mesh_load_from_file(TMP, &(gs_gfxt_mesh_import_options_t){
-            .layout = pip->mesh_layout,
-            .size = gs_dyn_array_size(pip->mesh_layout) * sizeof(gs_gfxt_mesh_layout_t),
-            .index_buffer_element_size = pip->desc.raster.index_buffer_element_size
-        }));
+        const bsf_shape_vert_t* sv = &verts[v];
+        for (uint32_t a = 0; a < gs_dyn_array_size(pip->mesh_layout); ++a)
+        {
+            switch (pip->mesh_layout[a].type)
+            {
+                case GS_GFXT_MESH_ATTRIBUTE_TYPE_POSITION: gs_byte_buffer_write(&vb, gs_vec3, sv->position); break;
+                case GS_GFXT_MESH_ATTRIBUTE_TYPE_NORMAL:   gs_byte_buffer_write(&vb, gs_vec3, gs_vec3_norm(sv->position)); break;
+                case GS_GFXT_MESH_ATTRIBUTE_TYPE_TANGENT:  gs_byte_buffer_write(&vb, gs_vec4, gs_v4(1.f, 0.f, 0.f, 1.f)); break;
+                case GS_GFXT_MESH_ATTRIBUTE_TYPE_TEXCOORD: gs_byte_buffer_write(&vb, gs_vec2, sv->uv); break;
+                case GS_GFXT_MESH_ATTRIBUTE_TYPE_COLOR:    gs_byte_buffer_write(&vb, gs_color_t, sv->color); break;
+                default: break;
+            }
+        }
     }
 
-    gs_graphics_texture_desc_t desc = (gs_graphics_texture_desc_t) {
-        .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
-        .min_filter = GS_GRAPHICS_TEXTURE_FILTER_LINEAR,
-        .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_LINEAR,
-        .wrap_s = GS_GRAPHICS_TEXTURE_WRAP_CLAMP_TO_EDGE,
-        .wrap_t = GS_GRAPHICS_TEXTURE_WRAP_CLAMP_TO_EDGE
+    gs_byte_buffer_t ib = gs_byte_buffer_new();
+    const bool32 wide = pip->desc.raster.index_buffer_element_size == sizeof(uint32_t);
+    for (uint32_t i = 0; i < gs_dyn_array_size(indices); ++i) {
+        if (wide) gs_byte_buffer_write(&ib, uint32_t, (uint32_t)indices[i]);
+        else      gs_byte_buffer_write(&ib, uint16_t, indices[i]);
+    }
+
+    gs_gfxt_mesh_t mesh = {0};
+    gs_gfxt_mesh_primitive_t prim = {
+        .vbo = gs_graphics_vertex_buffer_create(&(gs_graphics_vertex_buffer_desc_t){
+            .data = vb.data,
+            .size = vb.size
+        }),
+        .indices = gs_graphics_index_buffer_create(&(gs_graphics_index_buffer_desc_t){
+            .data = ib.data,
+            .size = ib.size
+        }),
+        .count = gs_dyn_array_size(indices)
     };
+    gs_dyn_array_push(mesh.primitives, prim);
 
-    struct {const char* key; const char* path; gs_graphics_texture_desc_t desc;} textures[] = {
-        {.key = "tex.slave", .path = "textures/slave.png", .desc = desc}, 
-        {.key = "tex.arwing", .path = "textures/arwing.png", .desc = desc}, 
-        {.key = "tex.vignette", .path = "textures/vignette.png", .desc = desc}, 
-        {.key = "tex.title_bg", .path = "textures/title_bg.png", .desc = (gs_graphics_texture_desc_t){
-            .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
-            .min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
-            .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST
-        }},
-        {.key = "tex.icon_inner_eye", .path = "textures/icon_inner_eye.png", .desc = (gs_graphics_texture_desc_t){
-            .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
-            .min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
-            .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST
-        }},
-        {.key = "tex.icon_polyphemus", .path = "textures/icon_polyphemus.png", .desc = (gs_graphics_texture_desc_t){
-            .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
-            .min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
-            .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST
-        }},
-        {.key = "tex.icon_spoon_bender", .path = "textures/icon_spoon_bender.png", .desc = (gs_graphics_texture_desc_t){
-            .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
-            .min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
-            .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST
-        }},
-        {.key = "tex.icon_sad_onion", .path = "textures/icon_sad_onion.png", .desc = (gs_graphics_texture_desc_t){
-            .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
-            .min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
-            .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST
-        }},
-        {.key = "tex.icon_magic_mushroom", .path = "textures/icon_magic_mushroom.png", .desc = (gs_graphics_texture_desc_t){
-            .format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8,
-            .min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
-            .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST
-        }},
-        {NULL}
+    gs_byte_buffer_free(&vb);
+    gs_byte_buffer_free(&ib);
+    gs_dyn_array_free(verts);
+    gs_dyn_array_free(indices);
+    return mesh;
+}
+
+GS_API_DECL void bsf_graphics_scene_immediate_push(bsf_graphics_scene_t* scene, bsf_shape_type shape, gs_gfxt_material_t* material, 
+        const gs_mat4* model, gs_color_t color, gs_gfxt_texture_t tex)
+{
+    bsf_render_immediate_t imm = {
+        .shape = shape,
+        .rend = {
+            .material = material,
+            .mesh = &scene->shapes[shape],
+            .model = *model,
+            .tint = gs_v4((float)color.r / 255.f, (float)color.g / 255.f, (float)color.b / 255.f, (float)color.a / 255.f)
+        },
+        .tex = tex
     };
+    gs_dyn_array_push(scene->immediates, imm);
+}
 
-    for (uint32_t i = 0; textures[i].key; ++i)
-    { 
-        gs_snprintfc(TMP, 256, "%s/%s", assets->asset_dir, textures[i].path);
-        gs_hash_table_insert(assets->textures, gs_hash_str64(textures[i].key), gs_gfxt_texture_load_from_file(TMP, &textures[i].desc, false, false));
-    }
+static int32_t bsf_render_immediate_compare(const void* a, const void* b)
+{
+    const bsf_render_immediate_t* ia = (const bsf_render_immediate_t*)a;
+    const bsf_render_immediate_t* ib = (const bsf_render_immediate_t*)b;
+    if (ia->shape != ib->shape) return ia->shape < ib->shape ? -1 : 1;
+    if (ia->rend.material != ib->rend.material) return ia->rend.material < ib->rend.material ? -1 : 1;
+    if (ia->tex.id != ib->tex.id) return ia->tex.id < ib->tex.id ? -1 : 1;
+    return 0;
+}
 
-    // Add in default texture
-    gs_hash_table_insert(assets->textures, gs_hash_str64("tex.default"), gs_gfxt_texture_generate_default());
+GS_API_DECL void bsf_graphics_camera_update(gs_command_buffer_t* cb, bsf_graphics_scene_t* scene, gs_camera_t* cam, gs_vec2 fbs)
+{
+    bsf_camera_uniforms_t data = {
+        .view = gs_camera_get_view(cam),
+        .proj = gs_camera_get_proj(cam, (int32_t)fbs.x, (int32_t)fbs.y)
+    };
+    gs_graphics_uniform_buffer_request_update(cb, scene->camera_ubo, &(gs_graphics_uniform_buffer_desc_t){
+        .data = &data,
+        .size = sizeof(data),
+        .usage = GS_GRAPHICS_BUFFER_USAGE_DYNAMIC
+    });
+}
 
-    // Sounds
-    struct {const char* key; const char* path;} sounds[] = {
-        {"audio.laser", "sounds/arwing_laser.mp3"},
-        {"audio.laser2", "sounds/laser2.wav"},
-        {"audio.bang", "sounds/bang.mp3"},
-        {"audio.explosion", "sounds/explosion.mp3"},
-        {"audio.explosion_boss", "sounds/explosion_boss.mp3"},
-        {"audio.health_pickup", "sounds/pickup.mp3"},
-        {"audio.bomb_pickup", "sounds/bomb_pickup.mp3"},
-        {"audio.menu_select", "sounds/menu_select.mp3"},
-        {"audio.start", "sounds/start.mp3"},
-        {"audio.pause", "sounds/pause.mp3"},
-        {"audio.arwing_hit", "sounds/arwing_hit.mp3"},
-        {"audio.hit_no_damage", "sounds/hit_no_damage.mp3"},
-        {"audio.music_boss", "sounds/music_boss.mp3"},
-        {"audio.music_title", "sounds/music_title.mp3"},
-        {"audio.music_level", "sounds/music_level.mp3"},
-        {"audio.music_level_complete", "sounds/music_level_complete.mp3"},
-        {NULL}
+GS_API_DECL void bsf_graphics_camera_bind(gs_command_buffer_t* cb, const bsf_graphics_scene_t* scene)
+{
+    gs_graphics_bind_desc_t binds = {
+        .uniform_buffers = {.desc = &(gs_graphics_bind_uniform_buffer_desc_t){
+            .buffer = scene->camera_ubo, 
+            .binding = BSF_CAMERA_UBO_BINDING
+        }}
     };
+    gs_graphics_apply_bindings(cb, &binds);
+}
 
-    for (uint32_t i = 0; sounds[i].key; ++i)
-    {
-        gs_snprintfc(TMP, 256, "%s/%s", assets->asset_dir, sounds[i].path);
-        gs_asset_audio_t snd = {0};
-        gs_asset_audio_load_from_file(TMP, &snd);
-        gs_hash_table_insert(assets->sounds, gs_hash_str64(sounds[i].key), snd);
+static gs_gfxt_material_t* bsf_graphics_extract_material(bsf_render_frame_t* frame, const gs_gfxt_material_t* src)
+{
+    // Handful of materials per frame, linear scan. Copied once however many renderables share it.
+    for (uint32_t i = 0; i < frame->material_count; ++i) {
+        if (frame->material_srcs[i] == src) return &frame->materials[i];
+    }
+    gs_assert(frame->material_count < BSF_RENDER_FRAME_MATERIAL_MAX);
+    gs_gfxt_material_t* mat = &frame->materials[frame->material_count];
+    frame->material_srcs[frame->material_count++] = src;
+
+    // Uniform buffers stay with the slot across frames, only their contents are copied
+    gs_byte_buffer_t uniform_data = mat->uniform_data.data ? mat->uniform_data : gs_byte_buffer_new();
+    gs_byte_buffer_t image_buffer_data = mat->image_buffer_data.data ? mat->image_buffer_data : gs_byte_buffer_new();
+    *mat = *src;
+    mat->uniform_data = uniform_data;
+    mat->image_buffer_data = image_buffer_data;
+
+    gs_byte_buffer_t* bufs[] = {&mat->uniform_data, &mat->image_buffer_data};
+    const gs_byte_buffer_t* srcs[] = {&src->uniform_data, &src->image_buffer_data};
+    for (uint32_t i = 0; i < 2; ++i) {
+        gs_byte_buffer_seek_to_beg(bufs[i]);
+        if (srcs[i]->size) gs_byte_buffer_write_bulk(bufs[i], srcs[i]->data, srcs[i]->size);
+        bufs[i]->size = srcs[i]->size;
+        gs_byte_buffer_seek_to_beg(bufs[i]);
     }
+    return mat;
+}
 
-    struct {const char* key; const char* paths[6];} cmaps[] = {
-        {
-            .key = "cmap.skybox",
-            .paths = {
-                "textures/sky_back.jpg", 
-                "textures/sky_back.jpg", 
-                "textures/sky_top.jpg", 
-                "textures/sky_bottom.jpg", 
-                "textures/sky_back.jpg", 
-                "textures/sky_back.jpg"
-            }
-        },
-        {NULL}
-    };
+static gs_gfxt_material_t* bsf_graphics_frame_material(bsf_render_frame_t* frame, const gs_gfxt_material_t* src)
+{
+    // Render thread side, only finds copies made by extract
+    for (uint32_t i = 0; i < frame->material_count; ++i) {
+        if (frame->material_srcs[i] == src) return &frame->materials[i];
+    }
+    gs_assert(false);
+    return NULL;
+}
 
-    for (uint32_t i = 0; cmaps[i].key; ++i) 
+static void bsf_graphics_extract(struct bsf_t* bsf, bsf_render_frame_t* frame)
+{
+    bsf_graphics_scene_t* scene = &bsf->scene;
+    frame->fbs = gs_platform_framebuffer_sizev(gs_platform_main_window());
+    frame->play = bsf->state == BSF_STATE_PLAY;
+    frame->camera = scene->camera.cam;
+
+    gs_dyn_array_clear(frame->renderables);
+    gs_dyn_array_clear(frame->particles);
+    frame->material_count = 0;
+    if (frame->play)
     {
-        gs_graphics_texture_desc_t desc = { 
-            .type = GS_GRAPHICS_TEXTURE_CUBEMAP, 
-            .min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
-            .mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST,
-            .wrap_s = GS_GRAPHICS_TEXTURE_WRAP_CLAMP_TO_EDGE,
-            .wrap_t = GS_GRAPHICS_TEXTURE_WRAP_CLAMP_TO_EDGE,
-            .wrap_r = GS_GRAPHICS_TEXTURE_WRAP_CLAMP_TO_EDGE
-        };
-        uint32_t w = 0, h = 0, ncmps = 0;
-        for (uint32_t c = 0; c < 6; ++c)
-        {
-            uint32_t nc = 0;
-            gs_snprintfc(PATH, 256, "%s/%s", assets->asset_dir, cmaps[i].paths[c]);
-            gs_util_load_texture_data_from_file(PATH, &w, &h, &nc, &desc.data[c], false);
-            gs_assert(desc.data[c]);
-            if (c == 0) {
-                desc.height = h;
-                desc.width = w; 
-                ncmps = nc;
-                desc.format = ncmps == 3 ? GS_GRAPHICS_TEXTURE_FORMAT_RGB8 : GS_GRAPHICS_TEXTURE_FORMAT_RGBA8;
-            } else {
-                gs_assert(w == desc.width); 
-                gs_assert(h == desc.height);
-                gs_assert(nc == ncmps);
-            }
-        } 
-        // Create cubemap texture
-        gs_gfxt_texture_t cmap = gs_graphics_texture_create(&desc); 
-        gs_hash_table_insert(assets->cubemaps, gs_hash_str64(cmaps[i].key), cmap);
-    } 
+        for (
+                gs_slot_array_iter it = gs_slot_array_iter_new(scene->renderables);
+                gs_slot_array_iter_valid(scene->renderables, it);
+                gs_slot_array_iter_advance(scene->renderables, it)
+        )
+        {
+            const bsf_renderable_t* rend = gs_slot_array_iter_getp(scene->renderables, it); 
+            if (rend->hidden) continue;
+            gs_dyn_array_push(frame->renderables, *rend);
+            frame->renderables[gs_dyn_array_size(frame->renderables) - 1].material = bsf_graphics_extract_material(frame, rend->material);
+        }
+        bsf_graphics_extract_material(frame, bsf->assets.hndl.mat_gsi);
+        bsf_graphics_extract_material(frame, bsf->assets.hndl.mat_world);
+        bsf_graphics_extract_material(frame, bsf->assets.hndl.models_skybox->material);
 
-    struct {const char* key; const char* pip;} materials[] = {
-        {.key = "mat.simple", .pip = "pip.simple"},
-        {.key = "mat.color", .pip = "pip.color"},
-        {.key = "mat.hit", .pip = "pip.hit"},
-        {.key = "mat.gsi", .pip = "pip.gsi"},
-        {.key = "mat.skybox", .pip = "pip.skybox"},
-        {NULL}
-    };
+        bsf_particles_extract(&bsf->particles, &frame->particles);
+        frame->particle_tex = GSI()->tex_default;
 
-    for (uint32_t i = 0; materials[i].key; ++i)
-    {
-        gs_gfxt_pipeline_t* pip = gs_hash_table_getp(assets->pipelines, gs_hash_str64(materials[i].pip));
-        gs_hash_table_insert(assets->materials, gs_hash_str64(materials[i].key), gs_gfxt_material_create(&(gs_gfxt_material_desc_t){.pip_func.hndl = pip}));
-    } 
+        const bsf_room_t* room = gs_slot_array_getp(bsf->run.rooms, bsf->run.room_ids[bsf->run.cell]);
+        frame->movement_type = room->movement_type;
 
-    struct {const char* key; const char* mat;} material_instances[] = {
-        {.key = "mat.ship_arwing", .mat = "mat.simple"},
-        {.key = "mat.slave", .mat = "mat.simple"},
-        {.key = "mat.bandit", .mat = "mat.simple"},
-        {.key = "mat.turret", .mat = "mat.simple"},
-        {.key = "mat.laser_player", .mat = "mat.color"},
-        {.key = "mat.laser_enemy", .mat = "mat.color"},
-        {.key = "mat.sky_sphere", .mat = "mat.color"},
-        {.key = "mat.brain", .mat = "mat.simple"},
-        {NULL}
-    }; 
+        // Scroll for rail ground
+        frame->scroll = gs_v3s(0.f);
+        if (frame->movement_type == BSF_MOVEMENT_RAIL)
+        {
+            const float t = gs_platform_elapsed_time();
+            const gs_platform_gamepad_t* gp = &gs_subsystem(platform)->input.gamepads[0];
+            const float speed_mod = gp->axes[GS_PLATFORM_JOYSTICK_AXIS_RTRIGGER] >= 0.4f || gs_platform_key_down(GS_KEYCODE_LEFT_SHIFT) ? 3.f : 1.f;
+            frame->scroll.z = fmod(t * 0.02f * speed_mod, 20.f);
+        }
+    }
 
-    for (uint32_t i = 0; material_instances[i].key; ++i)
-    {
-        gs_gfxt_material_t* mat = gs_hash_table_getp(assets->materials, gs_hash_str64(material_instances[i].mat));
-        gs_gfxt_material_t inst = gs_gfxt_material_deep_copy(mat);
-        gs_hash_table_insert(assets->materials, gs_hash_str64(material_instances[i].key), inst);
-    } 
-    
-    struct {const char* key; const char* path; int32_t pt;} fonts[] = {
-        {.key = "font.arwing_h0", .path = "fonts/arwing.ttf", .pt = 90},
-        {.key = "font.arwing_h1", .path = "fonts/arwing.ttf", .pt = 32},
-        {.key = "font.arwing_h2", .path = "fonts/arwing.ttf", .pt = 24},
-        {.key = "font.arwing_p", .path = "fonts/arwing.ttf", .pt = 16},
-        {.key = "font.upheaval_h0", .path = "fonts/upheaval.ttf", .pt = 48},
-        {.key = "font.upheaval_h1", .path = "fonts/upheaval.ttf", .pt = 32},
-        {.key = "font.upheaval_h2", .path = "fonts/upheaval.ttf", .pt = 24},
-        {.key = "font.upheaval_p", .path = "fonts/upheaval.ttf", .pt = 16},
-        {NULL}
-    }; 
+    // Immediates change hands, scene collects the next frame into the emptied array of this one
+    gs_dyn_array(bsf_render_immediate_t) imm = frame->immediates;
+    frame->immediates = scene->immediates;
+    scene->immediates = imm;
+    gs_dyn_array_clear(scene->immediates);
+    for (uint32_t i = 0; i < gs_dyn_array_size(frame->immediates); ++i) {
+        frame->immediates[i].rend.material = bsf_graphics_extract_material(frame, frame->immediates[i].rend.material);
+    }
 
-    for (uint32_t i = 0; fonts[i].key; ++i) 
+    // gsi and gui lists are reset by the next frame's update, so they're recorded now
+    gs_command_buffer_t* cb = &frame->overlay;
+    gs_graphics_renderpass_begin(cb, (gs_renderpass){0}); 
     {
-        gs_snprintfc(TMP, 256, "%s/%s", assets->asset_dir, fonts[i].path);
-        gs_asset_font_t* font = gs_malloc_init(gs_asset_font_t); 
-        gs_asset_font_load_from_file(TMP, font, fonts[i].pt);
-        gs_hash_table_insert(bsf->gs.gui.font_stash, gs_hash_str64(fonts[i].key), font);
-    } 
+        gs_graphics_set_viewport(cb, 0, 0, (uint32_t)frame->fbs.x, (uint32_t)frame->fbs.y);
 
-    // Skybox
-    {
-        // Vertex data for skybox
-        float v_data[] = {
-            -1.0f,  1.0f,  1.0f, 
-            -1.0f, -1.0f,  1.0f, 
-             1.0f, -1.0f,  1.0f,
-             1.0f,  1.0f,  1.0f, 
-            -1.0f,  1.0f, -1.0f, 
-            -1.0f, -1.0f, -1.0f, 
-             1.0f, -1.0f, -1.0f, 
-             1.0f,  1.0f, -1.0f 
-        };
+        // Render all gsi
+        gsi_renderpass_submit_ex(&bsf->gs.gsi, cb, NULL);
 
-        uint16_t i_data[] = {
-           0, 1, 2, 3,
-           3, 2, 6, 7,
-           7, 6, 5, 4,
-           4, 5, 1, 0,
-           0, 3, 7, 4, // T
-           1, 2, 6, 5  // B
-        };
+        // Render all gui
+        gs_gui_render(&bsf->gs.gui, cb);
+    }
+    gs_graphics_renderpass_end(cb);
+}
 
-        bsf_model_t skybox = {0}; 
+// Reads only the frame and render scratch of the scene (queue, cull, instancing), so runs on the render thread
+static void bsf_graphics_build(bsf_graphics_scene_t* scene, bsf_render_frame_t* frame)
+{
+    bsf_t* bsf = gs_user_data(bsf_t);
+    gs_command_buffer_t* cb = &frame->cb;
+    const gs_vec2 fbs = frame->fbs;
+    const float t0 = gs_platform_elapsed_time();
+
+    // Render pass
+    gs_graphics_renderpass_begin(cb, (gs_renderpass){0}); 
+    { 
+        gs_graphics_clear_desc_t clear = {.actions = &(gs_graphics_clear_action_t){.color = {0.05f, 0.05, 0.05, 1.f}}}; 
+        gs_graphics_clear(cb, &clear);
+        gs_graphics_set_viewport(cb, 0, 0, (uint32_t)fbs.x, (uint32_t)fbs.y);
+
+        if (frame->play)
+        {
+            gs_camera_t* cam = &frame->camera;
+            const gs_mat4 vp = gs_camera_get_view_projection(cam, fbs.x, fbs.y); 
+            bsf_graphics_camera_update(cb, scene, cam, fbs);
+
+            // Gather bounds of all renderables and cull against the camera frustum
+            bsf_render_cull_t* cull = &scene->cull;
+            bsf_render_cull_clear(cull, &vp);
+            for (uint32_t i = 0; i < gs_dyn_array_size(frame->renderables); ++i) {
+                bsf_render_cull_push(cull, &frame->renderables[i]);
+            } 
+            bsf_render_cull_test(cull);
+
+            // Queue visible renderables, sorted so state only changes when the key prefix does
+            bsf_render_queue_t* queue = &scene->queue;
+            bsf_render_queue_clear(queue);
+            const float proj_scale = 1.f / tanf(gs_deg2rad(cam->fov) * 0.5f);
+            for (uint32_t i = 0; i < cull->count; ++i)
+            {
+                if (!cull->visible[i]) continue;
+                bsf_renderable_t* rend = cull->rends[i];
+                const gs_vec3 pos = gs_v3(cull->x[i], cull->y[i], cull->z[i]);
+                const float dist = gs_vec3_dist(pos, cam->transform.position);
+
+                // Detail level from projected size of bounds
+                uint32_t level = 0;
+                if (rend->lod)
+                {
+                    const float size = cull->r[i] * proj_scale / gs_max(dist, 0.001f);
+                    while (level + 1 < rend->lod->count && size < rend->lod->sizes[level]) level++;
+                    rend->mesh = rend->lod->levels[level];
+                }
+                queue->stats.lods[level]++;
+
+                bsf_render_queue_push(queue, rend, dist / cam->far_plane);
+            }
+            bsf_render_queue_sort(queue);
+
+            // Main render pass for scene 
+            uint64_t prev = UINT64_MAX;
+            uint32_t group = 0;
+            for (uint32_t i = 0; i < queue->count; ++i)
+            {
+                const uint64_t key = queue->items[i].key;
+                bsf_renderable_t* rend = queue->items[i].rend;
+                gs_gfxt_material_t* mat = rend->material;
+                gs_gfxt_mesh_t* mesh = rend->mesh; 
+
+                // Run of the same pipeline, material and mesh goes out as one instanced draw if the pipeline has a twin
+                gs_gfxt_pipeline_t* ipip = bsf_render_instancing_get(&scene->instancing, 
+                    GS_GFXT_RAW_DATA(&mat->desc.pip_func, gs_gfxt_pipeline_t));
+                if (ipip)
+                {
+                    uint32_t end = i + 1;
+                    while (end < queue->count && (queue->items[end].key >> BSF_RENDER_KEY_MESH_SHIFT) == (key >> BSF_RENDER_KEY_MESH_SHIFT)) {
+                        end++;
+                    }
+                    bsf_graphics_draw_instanced(cb, scene, group++, &queue->items[i], end - i, ipip, NULL);
+                    i = end - 1;
+                    prev = UINT64_MAX;
+                    continue;
+                }
+
+                // Binding a pipeline resets buffer bindings, so mesh has to follow
+                const bool32 pip_changed = (key >> BSF_RENDER_KEY_PIPELINE_SHIFT) != (prev >> BSF_RENDER_KEY_PIPELINE_SHIFT);
+                const bool32 mesh_changed = pip_changed || 
+                    ((key >> BSF_RENDER_KEY_MESH_SHIFT) & 0xFFFF) != ((prev >> BSF_RENDER_KEY_MESH_SHIFT) & 0xFFFF);
+                prev = key;
+
+                if (pip_changed) {
+                    gs_gfxt_material_bind(cb, mat);
+                    bsf_graphics_camera_bind(cb, scene);
+                    queue->stats.pipeline_binds++;
+                }
+
+                // View projection comes from the camera block, uniforms only carry the model
+                BSF_MATERIAL_SET_UNIFORM(&bsf->assets, mat, u_model, &rend->model);
+                gs_gfxt_material_bind_uniforms(cb, mat);
+
+                // Single primitive meshes stay bound for a run of the same mesh
+                if (gs_dyn_array_size(mesh->primitives) == 1)
+                {
+                    gs_gfxt_mesh_primitive_t* prim = &mesh->primitives[0];
+                    if (mesh_changed) {
+                        gs_graphics_bind_desc_t binds = {
+                            .vertex_buffers = {.desc = &(gs_graphics_bind_vertex_buffer_desc_t){.buffer = prim->vbo}},
+                            .index_buffers = {.desc = &(gs_graphics_bind_index_buffer_desc_t){.buffer = prim->indices}}
+                        };
+                        gs_graphics_apply_bindings(cb, &binds);
+                        queue->stats.mesh_binds++;
+                    }
+                    gs_graphics_draw(cb, &(gs_graphics_draw_desc_t){.start = 0, .count = prim->count});
+                }
+                else
+                {
+                    gs_gfxt_mesh_draw(cb, mesh); 
+                    queue->stats.mesh_binds += gs_dyn_array_size(mesh->primitives);
+                }
+                queue->stats.draws++;
+                queue->stats.instances++;
+            } 
 
-        // Skybox vbo/ibo
-        skybox.vbo = gs_graphics_vertex_buffer_create(&(gs_graphics_vertex_buffer_desc_t){
-            .data = v_data,
-            .size = sizeof(v_data)
-        });
+            // Immediate shapes, one instanced draw per shape, material and texture
+            gs_dyn_array(bsf_render_immediate_t) imm = frame->immediates;
+            qsort(imm, gs_dyn_array_size(imm), sizeof(bsf_render_immediate_t), bsf_render_immediate_compare);
+            for (uint32_t i = 0; i < gs_dyn_array_size(imm); )
+            {
+                gs_dyn_array_clear(scene->immediate_items);
+                uint32_t end = i;
+                while (end < gs_dyn_array_size(imm) && !bsf_render_immediate_compare(&imm[i], &imm[end])) {
+                    gs_dyn_array_push(scene->immediate_items, ((bsf_render_item_t){.rend = &imm[end].rend}));
+                    end++;
+                }
+                gs_gfxt_pipeline_t* ipip = bsf_render_instancing_get(&scene->instancing, 
+                    GS_GFXT_RAW_DATA(&imm[i].rend.material->desc.pip_func, gs_gfxt_pipeline_t));
+                gs_assert(ipip);
+                bsf_graphics_draw_instanced(cb, scene, group++, scene->immediate_items, end - i, ipip, &imm[i].tex);
+                i = end;
+            }
 
-        skybox.ibo = gs_graphics_index_buffer_create(&(gs_graphics_index_buffer_desc_t){
-            .data = i_data, 
-            .size = sizeof(i_data)
-        });
+            // Particles, whole pool in one instanced draw
+            if (!gs_dyn_array_empty(frame->particles))
+            {
+                gs_gfxt_material_t* mat = bsf_graphics_frame_material(frame, bsf->assets.hndl.mat_gsi);
+                gs_gfxt_pipeline_t* ipip = bsf_render_instancing_get(&scene->instancing, 
+                    GS_GFXT_RAW_DATA(&mat->desc.pip_func, gs_gfxt_pipeline_t));
+                bsf_graphics_draw_instances(cb, scene, group++, mat, &scene->shapes[BSF_SHAPE_BOX], frame->particles, 
+                    gs_dyn_array_size(frame->particles), ipip, &frame->particle_tex);
+            }
 
-        skybox.material = gs_hash_table_getp(assets->materials, gs_hash_str64("mat.skybox"));
+            // Ground and backdrop
+            bsf_world_draw(bsf, cb, bsf_graphics_frame_material(frame, bsf->assets.hndl.mat_world), frame->movement_type, frame->scroll);
 
-        gs_hash_table_insert(assets->models, gs_hash_str64("models.skybox"), skybox);
+            // Render skybox
+            bsf_model_t* skybox = bsf->assets.hndl.models_skybox;
+				gs_gfxt_texture_t* cmap = bsf->assets.hndl.cmap_skybox;
+            gs_assert(skybox);
+				gs_assert(cmap);
+            gs_gfxt_material_t* skybox_mat = bsf_graphics_frame_material(frame, skybox->material);
+            gs_mat4 model = gs_mat4_scalev(gs_v3s(2000.f));
+				BSF_MATERIAL_SET_UNIFORM(&bsf->assets, skybox_mat, u_tex, cmap);
+            BSF_MATERIAL_SET_UNIFORM(&bsf->assets, skybox_mat, u_model, &model);
+            gs_gfxt_material_bind(cb, skybox_mat);
+            gs_gfxt_material_bind_uniforms(cb, skybox_mat);
+            bsf_graphics_camera_bind(cb, scene);
+            gs_graphics_bind_desc_t binds = {
+                .vertex_buffers = {.desc = &(gs_graphics_bind_vertex_buffer_desc_t){.buffer = skybox->vbo}},
+                .index_buffers = {.desc = &(gs_graphics_bind_index_buffer_desc_t){.buffer = skybox->ibo}}
+            };
+            gs_graphics_apply_bindings(cb, &binds);
+            gs_graphics_draw(cb, &(gs_graphics_draw_desc_t){.start = 0, .count = 36});
+        }
     } 
+    gs_graphics_renderpass_end(cb);
 
-    struct {const char* key; const char* path;} style_sheets[] = {
-        {.key = "ss.title", .path = "style_sheets/bsf_title.ss"},
-        {NULL}
-    }; 
+    frame->stats = (bsf_render_stats_t){
+        .queue = scene->queue.stats, 
+        .cull = scene->cull.stats, 
+        .encode_ms = gs_platform_elapsed_time() - t0
+    };
+}
 
-    for (uint32_t i = 0; style_sheets[i].key; ++i)
+#ifdef BSF_RENDER_THREAD
+static void* bsf_graphics_thread(void* data)
+{
+    bsf_graphics_scene_t* scene = (bsf_graphics_scene_t*)data;
+    bsf_render_frames_t* frames = &scene->frames;
+    pthread_mutex_lock(&frames->lock);
+    for (;;)
     {
-        gs_snprintfc(TMP, 256, "%s/%s", assets->asset_dir, style_sheets[i].path);
-        gs_gui_style_sheet_t ss = gs_gui_style_sheet_load_from_file(&bsf->gs.gui, TMP);
-        gs_hash_table_insert(assets->style_sheets, gs_hash_str64(style_sheets[i].key), ss);
+        while (!frames->job && !frames->quit) {
+            pthread_cond_wait(&frames->cond, &frames->lock);
+        }
+        if (!frames->job) break;
+
+        bsf_render_frame_t* frame = frames->job;
+        pthread_mutex_unlock(&frames->lock);
+        bsf_graphics_build(scene, frame);
+        pthread_mutex_lock(&frames->lock);
+
+        frames->job = NULL;
+        pthread_cond_broadcast(&frames->cond);
     }
+    pthread_mutex_unlock(&frames->lock);
+    return NULL;
 }
+#endif
 
-GS_API_DECL void bsf_dbg_reload_ss(struct bsf_t* bsf)
+static void bsf_graphics_frames_wait(bsf_render_frames_t* frames)
 {
-    gs_gui_style_sheet_t* ss = gs_hash_table_getp(bsf->assets.style_sheets, gs_hash_str64("ss.title"));
-    gs_gui_style_sheet_destroy(&bsf->gs.gui, ss);
-    gs_snprintfc(TMP, 256, "%s/%s", bsf->assets.asset_dir, "style_sheets/bsf_title.ss");
-    *ss = gs_gui_style_sheet_load_from_file(&bsf->gs.gui, TMP); 
+#ifdef BSF_RENDER_THREAD
+    pthread_mutex_lock(&frames->lock);
+    while (frames->job) {
+        pthread_cond_wait(&frames->cond, &frames->lock);
+    }
+    pthread_mutex_unlock(&frames->lock);
+#endif
 }
 
-//=== BSF Graphics ===//
-
-GS_API_DECL uint32_t bsf_graphics_scene_renderable_create(bsf_graphics_scene_t* scene, const bsf_renderable_desc_t* desc)
+GS_API_DECL void bsf_graphics_frames_init(bsf_graphics_scene_t* scene)
 {
-    return gs_slot_array_insert(scene->renderables, *desc);
+    bsf_render_frames_t* frames = &scene->frames;
+    for (uint32_t i = 0; i < 2; ++i) {
+        frames->frames[i].cb = gs_command_buffer_new();
+        frames->frames[i].overlay = gs_command_buffer_new();
+    }
+#ifdef BSF_RENDER_THREAD
+    pthread_mutex_init(&frames->lock, NULL);
+    pthread_cond_init(&frames->cond, NULL);
+    pthread_create(&frames->thread, NULL, bsf_graphics_thread, scene);
+#endif
 }
 
-GS_API_DECL void bsf_graphics_scene_renderable_destroy(bsf_graphics_scene_t* scene, uint32_t hndl)
+GS_API_DECL void bsf_graphics_frames_free(bsf_graphics_scene_t* scene)
+{
+    bsf_render_frames_t* frames = &scene->frames;
+#ifdef BSF_RENDER_THREAD
+    pthread_mutex_lock(&frames->lock);
+    frames->quit = true;
+    pthread_cond_broadcast(&frames->cond);
+    pthread_mutex_unlock(&frames->lock);
+    pthread_join(frames->thread, NULL);
+    pthread_cond_destroy(&frames->cond);
+    pthread_mutex_destroy(&frames->lock);
+#endif
+    for (uint32_t i = 0; i < 2; ++i) {
+        gs_command_buffer_free(&frames->frames[i].cb);
+        gs_command_buffer_free(&frames->frames[i].overlay);
+        gs_dyn_array_free(frames->frames[i].renderables);
+        gs_dyn_array_free(frames->frames[i].immediates);
+        gs_dyn_array_free(frames->frames[i].particles);
+        for (uint32_t m = 0; m < BSF_RENDER_FRAME_MATERIAL_MAX; ++m) {
+            gs_byte_buffer_free(&frames->frames[i].materials[m].uniform_data);
+            gs_byte_buffer_free(&frames->frames[i].materials[m].image_buffer_data);
+        }
+    }
+    memset(frames, 0, sizeof(bsf_render_frames_t));
+}
+
+GS_API_DECL void bsf_graphics_render(struct bsf_t* bsf)
 {
-    if (gs_slot_array_handle_valid(scene->renderables, hndl))
+    bsf_graphics_scene_t* scene = &bsf->scene;
+    bsf_render_frames_t* frames = &scene->frames;
+    bsf_render_frame_t* frame = &frames->frames[frames->extract];
+
+    // Copy out render state, simulation is free to change the scene from here on
+    bsf_graphics_extract(bsf, frame);
+
+    // Render thread is done with the previous frame once this returns
+    bsf_graphics_frames_wait(frames);
+
+    // GPU resources are only created here, on the thread that owns the context
+    bsf_assets_stream(&bsf->assets);
+    bsf_assets_reload(bsf);
+    if (frame->play && !bsf->world[frame->movement_type].baked) {
+        bsf_world_bake(bsf, frame->movement_type);
+    }
+    bsf_render_instancing_reserve(&scene->instancing, gs_dyn_array_size(frame->renderables) + gs_dyn_array_size(frame->immediates) + 1);
+
+#ifdef BSF_RENDER_THREAD
+    // Hand this frame over and submit the previous one while it's built
+    pthread_mutex_lock(&frames->lock);
+    frames->job = frame;
+    pthread_cond_broadcast(&frames->cond);
+    pthread_mutex_unlock(&frames->lock);
+
+    bsf_render_frame_t* ready = frames->pending ? &frames->frames[frames->extract ^ 1] : NULL;
+    frames->pending = true;
+    frames->extract ^= 1;
+#else
+    bsf_graphics_build(scene, frame);
+    bsf_render_frame_t* ready = frame;
+#endif
+
+	// Submit command buffers for GPU
+    if (ready)
     {
-        gs_slot_array_erase(scene->renderables, hndl);
+        if (bsf->capture.fp && ready->play) {
+            bsf_capture_frame(bsf, ready);
+        }
+        gs_graphics_command_buffer_submit(&ready->cb);
+        gs_graphics_command_buffer_submit(&ready->overlay);
+        scene->stats = ready->stats;
     }
 }
 
-GS_API_DECL void bsf_graphics_render(struct bsf_t* bsf)
+//=== BSF World ===//
+
+static void bsf_world_push_box(gs_dyn_array(bsf_world_vert_t)* verts, gs_dyn_array(uint32_t)* indices, 
+        gs_vec3 c, gs_vec3 he, gs_color_t col)
 {
-    gs_command_buffer_t* cb = &bsf->gs.cb;
-    gs_immediate_draw_t* gsi = &bsf->gs.gsi;
-    gs_gui_context_t* gui = &bsf->gs.gui; 
-	gs_vec2 fbs = gs_platform_framebuffer_sizev(gs_platform_main_window()); 
+    const uint32_t base = gs_dyn_array_size(*verts);
+    for (uint32_t i = 0; i < 8; ++i) {
+        gs_vec3 p = gs_v3(
+            c.x + ((i & 1) ? he.x : -he.x),
+            c.y + ((i & 2) ? he.y : -he.y),
+            c.z + ((i & 4) ? he.z : -he.z)
+        );
+        gs_dyn_array_push(*verts, ((bsf_world_vert_t){.position = p, .color = col}));
+    }
 
-    // Render pass
-    gs_graphics_renderpass_begin(cb, (gs_renderpass){0}); 
-    { 
-        gs_graphics_clear_desc_t clear = {.actions = &(gs_graphics_clear_action_t){.color = {0.05f, 0.05, 0.05, 1.f}}}; 
-        gs_graphics_clear(cb, &clear);
-        gs_graphics_set_viewport(cb, 0, 0, (uint32_t)fbs.x, (uint32_t)fbs.y);
+    static const uint32_t faces[] = {
+        0, 1, 3, 0, 3, 2,   // -z
+        4, 6, 7, 4, 7, 5,   // +z
+        0, 2, 6, 0, 6, 4,   // -x
+        1, 5, 7, 1, 7, 3,   // +x
+        0, 4, 5, 0, 5, 1,   // -y
+        2, 3, 7, 2, 7, 6    // +y
+    };
+    for (uint32_t i = 0; i < sizeof(faces) / sizeof(faces[0]); ++i) {
+        gs_dyn_array_push(*indices, base + faces[i]);
+    }
+}
+
+static void bsf_world_push_rect(gs_dyn_array(bsf_world_vert_t)* verts, gs_dyn_array(uint32_t)* indices, 
+        gs_vec3 mn, gs_vec3 mx, gs_color_t col)
+{
+    // Ground rects, flat on xz
+    const uint32_t base = gs_dyn_array_size(*verts);
+    gs_dyn_array_push(*verts, ((bsf_world_vert_t){.position = gs_v3(mn.x, mn.y, mn.z), .color = col}));
+    gs_dyn_array_push(*verts, ((bsf_world_vert_t){.position = gs_v3(mx.x, mn.y, mn.z), .color = col}));
+    gs_dyn_array_push(*verts, ((bsf_world_vert_t){.position = gs_v3(mx.x, mx.y, mx.z), .color = col}));
+    gs_dyn_array_push(*verts, ((bsf_world_vert_t){.position = gs_v3(mn.x, mx.y, mx.z), .color = col}));
+    const uint32_t quad[] = {0, 1, 2, 0, 2, 3};
+    for (uint32_t i = 0; i < 6; ++i) {
+        gs_dyn_array_push(*indices, base + quad[i]);
+    }
+}
 
-        switch (bsf->state)
+static gs_color_t bsf_world_ground_color(float ct)
+{
+    gs_color_t c0 = gs_color(6, 59, 0, 255); 
+    gs_color_t c1 = gs_color(14, 255, 0, 255); 
+    return gs_color(
+        (uint8_t)(255.f * gs_interp_smoothstep((float)c0.r / 255.f, (float)c1.r / 255.f, ct)),
+        (uint8_t)(255.f * gs_interp_smoothstep((float)c0.g / 255.f, (float)c1.g / 255.f, ct)), 
+        (uint8_t)(255.f * gs_interp_smoothstep((float)c0.b / 255.f, (float)c1.b / 255.f, ct)),
+        (uint8_t)(255.f * gs_interp_smoothstep((float)c0.a / 255.f, (float)c1.a / 255.f, ct))
+    );
+}
+
+GS_API_DECL void bsf_world_bake(struct bsf_t* bsf, int16_t movement_type)
+{
+    bsf_world_geometry_t* world = &bsf->world[movement_type];
+    gs_dyn_array(bsf_world_vert_t) verts[BSF_WORLD_LAYER_COUNT] = {0};
+    gs_dyn_array(uint32_t) indices[BSF_WORLD_LAYER_COUNT] = {0};
+
+    switch (movement_type)
+    {
+        case BSF_MOVEMENT_FREE_RANGE:
         {
-            case BSF_STATE_PLAY:
+            const float sz = 2000;
+            const float sx = 2000;
+            const float step = 20.f;
+            for (float r = -sz; r <= sz; r += step)
             {
-                // Need to eventually sort all renderables by pipelines to reduce binds
+                const gs_color_t color = bsf_world_ground_color(gs_map_range(-sz, sz, 0.f, 1.f, r));
+                bsf_world_push_rect(&verts[BSF_WORLD_LAYER_STATIC], &indices[BSF_WORLD_LAYER_STATIC], 
+                    gs_v3(-sx, 0.f, r), gs_v3(2 * sx, 0.f, r + step), color);
+            }
+        } break;
 
-                const gs_mat4 vp = gs_camera_get_view_projection(&bsf->scene.camera.cam, fbs.x, fbs.y); 
+        case BSF_MOVEMENT_RAIL:
+        {
+            const float sz = 150;
+            const float sx = 500;
+            const float step = 20.f;
+            const gs_vec3 kb = {BSF_ROOM_BOUND_X, BSF_ROOM_BOUND_Y, BSF_ROOM_BOUND_Z}; 
 
-                // Main render pass for scene 
-                for (
-                        gs_slot_array_iter it = gs_slot_array_iter_new(bsf->scene.renderables);
-                        gs_slot_array_iter_valid(bsf->scene.renderables, it);
-                        gs_slot_array_iter_advance(bsf->scene.renderables, it)
-                )
+            // Ground columns, scrolled
+            for (float r = -sz * 0.5f; r <= sz; r += step)
+            { 
+                for (float c = -80; c < 80; c += step)
                 {
-                    bsf_renderable_t* rend = gs_slot_array_iter_getp(bsf->scene.renderables, it); 
-                    gs_gfxt_material_t* mat = rend->material;
-                    gs_gfxt_mesh_t* mesh = rend->mesh; 
-                    gs_mat4 mvp = gs_mat4_mul(vp, rend->model);
+                    bsf_world_push_box(&verts[BSF_WORLD_LAYER_SCROLL], &indices[BSF_WORLD_LAYER_SCROLL], 
+                        gs_v3(c, 0.f, r), gs_v3s(0.1f), GS_COLOR_WHITE);
+                }
+            }
 
-                    gs_gfxt_material_set_uniform(mat, "u_mvp", &mvp);
-                    gs_gfxt_material_bind(cb, mat);
-                    gs_gfxt_material_bind_uniforms(cb, mat);
-                    gs_gfxt_mesh_draw(cb, mesh); 
-                } 
+            // Ground gradient
+            for (float r = -sz; r <= sz; r += step)
+            {
+                const gs_color_t color = bsf_world_ground_color(gs_map_range(-sz, sz, 0.f, 1.f, r));
+                bsf_world_push_rect(&verts[BSF_WORLD_LAYER_STATIC], &indices[BSF_WORLD_LAYER_STATIC], 
+                    gs_v3(-sx, 0.f, r), gs_v3(2 * sx, 0.f, r + step), color);
+            }
 
-                // Render skybox
-                bsf_model_t* skybox = gs_hash_table_getp(bsf->assets.models, gs_hash_str64("models.skybox"));
-				gs_gfxt_texture_t* cmap = gs_hash_table_getp(bsf->assets.cubemaps, gs_hash_str64("cmap.skybox"));
-                gs_assert(skybox);
-				gs_assert(cmap);
-                gs_mat4 model = gs_mat4_scalev(gs_v3s(2000.f));
-                gs_mat4 mvp = gs_mat4_mul(vp, model);
-				gs_gfxt_material_set_uniform(skybox->material, "u_tex", cmap);
-                gs_gfxt_material_set_uniform(skybox->material, "u_mvp", &mvp);
-                gs_gfxt_material_bind(cb, skybox->material);
-                gs_gfxt_material_bind_uniforms(cb, skybox->material);
-                gs_graphics_bind_desc_t binds = {
-                    .vertex_buffers = {.desc = &(gs_graphics_bind_vertex_buffer_desc_t){.buffer = skybox->vbo}},
-                    .index_buffers = {.desc = &(gs_graphics_bind_index_buffer_desc_t){.buffer = skybox->ibo}}
-                };
-                gs_graphics_apply_bindings(cb, &binds);
-                gs_graphics_draw(cb, &(gs_graphics_draw_desc_t){.start = 0, .count = 36});
-            } break;
+            // Tiny, moving guide boxes along the horizon, scrolled
+            const float y = gs_perlin2(sx, sz);
+            for (float c = -sx; c < sx; c += step)
+            {
+                bsf_world_push_box(&verts[BSF_WORLD_LAYER_SCROLL], &indices[BSF_WORLD_LAYER_SCROLL], 
+                    gs_v3(c, y * 0.5f, sz), gs_v3(1.f, y * 0.5f, 1.f), gs_color(0, 255, 0, 255));
+            }
+
+            // Do random boxes based on seed value (for obstacles) 
+            gs_mt_rand_t rand = gs_rand_seed(gs_hash_str64("mountains"));
+            for (uint32_t i = 0; i < 100; ++i) 
+            {
+                float rx = gs_rand_gen_range(&rand, -500, 500.f); 
+                float rsx = gs_rand_gen_range(&rand, 1.f, 50.f); 
+                float ry = gs_rand_gen_range(&rand, 1.f, kb.y); 
+                float rz = 1.f; 
+                bsf_world_push_box(&verts[BSF_WORLD_LAYER_STATIC], &indices[BSF_WORLD_LAYER_STATIC], 
+                    gs_v3(rx, ry * 0.5f, -kb.z), gs_v3(rsx, ry * 0.5f, rz), gs_color(20, 100, 255, 255));
+            }
+        } break;
+    }
+
+    gs_gfxt_material_t* mat = bsf->assets.hndl.mat_world;
+    for (uint32_t i = 0; i < BSF_WORLD_LAYER_COUNT; ++i)
+    {
+        world->counts[i] = gs_dyn_array_size(indices[i]);
+        world->layers[i].material = mat;
+        if (world->counts[i])
+        {
+            world->layers[i].vbo = gs_graphics_vertex_buffer_create(&(gs_graphics_vertex_buffer_desc_t){
+                .data = verts[i],
+                .size = gs_dyn_array_size(verts[i]) * sizeof(bsf_world_vert_t)
+            });
+            world->layers[i].ibo = gs_graphics_index_buffer_create(&(gs_graphics_index_buffer_desc_t){
+                .data = indices[i],
+                .size = world->counts[i] * sizeof(uint32_t)
+            });
         }
+        gs_dyn_array_free(verts[i]);
+        gs_dyn_array_free(indices[i]);
+    }
+    world->baked = true;
+}
 
-        // Render all gsi
-        gsi_renderpass_submit_ex(gsi, cb, NULL);
+GS_API_DECL void bsf_world_draw(struct bsf_t* bsf, gs_command_buffer_t* cb, gs_gfxt_material_t* mat, int16_t movement_type, gs_vec3 scroll)
+{
+    bsf_world_geometry_t* world = &bsf->world[movement_type];
+    gs_assert(world->baked);
 
-        // Render all gui
-        gs_gui_render(gui, cb);
-    } 
-    gs_graphics_renderpass_end(cb);
+    // Layers share the world material, drawn through the frame's copy of it
+    for (uint32_t i = 0; i < BSF_WORLD_LAYER_COUNT; ++i)
+    {
+        if (!world->counts[i]) continue;
+        bsf_model_t* layer = &world->layers[i];
+        const gs_vec3 offset = i == BSF_WORLD_LAYER_SCROLL ? scroll : gs_v3s(0.f);
+        BSF_MATERIAL_SET_UNIFORM(&bsf->assets, mat, u_scroll, &offset);
+        gs_gfxt_material_bind(cb, mat);
+        gs_gfxt_material_bind_uniforms(cb, mat);
+        bsf_graphics_camera_bind(cb, &bsf->scene);
+        gs_graphics_bind_desc_t binds = {
+            .vertex_buffers = {.desc = &(gs_graphics_bind_vertex_buffer_desc_t){.buffer = layer->vbo}},
+            .index_buffers = {.desc = &(gs_graphics_bind_index_buffer_desc_t){.buffer = layer->ibo}}
+        };
+        gs_graphics_apply_bindings(cb, &binds);
+        gs_graphics_draw(cb, &(gs_graphics_draw_desc_t){.start = 0, .count = world->counts[i]});
+    }
+}
 
-	// Submit command buffer for GPU
-	gs_graphics_command_buffer_submit(cb);
+GS_API_DECL void bsf_world_free(struct bsf_t* bsf)
+{
+    for (uint32_t m = 0; m < BSF_MOVEMENT_COUNT; ++m)
+    {
+        bsf_world_geometry_t* world = &bsf->world[m];
+        for (uint32_t i = 0; i < BSF_WORLD_LAYER_COUNT; ++i)
+        {
+            if (!world->counts[i]) continue;
+            gs_graphics_vertex_buffer_destroy(world->layers[i].vbo);
+            gs_graphics_index_buffer_destroy(world->layers[i].ibo);
+        }
+        memset(world, 0, sizeof(bsf_world_geometry_t));
+    }
 }
 
 //=== BSF Entities ===// 
 
 GS_API_DECL void bsf_entities_init(struct bsf_t* bsf)
 {
+    // World persists between runs, reset through base snapshot instead (see bsf_entities_reset)
+    if (bsf->entities.world) {
+        return;
+    }
+
     bsf->entities.world = ecs_init();
 
 #define ECS_REGISTER_COMP(T)\
@@ -1210,11 +4843,15 @@ GS_API_DECL void bsf_entities_init(struct bsf_t* bsf)
 
     ECS_REGISTER_COMP(bsf_component_renderable_t); 
     ecs_set_component_actions_w_id(bsf->entities.world, ecs_id(bsf_component_renderable_t), &(EcsComponentLifecycle) {
-        .dtor = bsf_component_renderable_dtor
+        .ctor = bsf_component_renderable_ctor,
+        .dtor = bsf_component_renderable_dtor,
+        .copy = bsf_component_renderable_copy,
+        .move = bsf_component_renderable_move
     });
 
     ECS_REGISTER_COMP(bsf_component_transform_t);
-    ECS_REGISTER_COMP(bsf_component_physics_t); 
+    ECS_REGISTER_COMP(bsf_component_velocity_t); 
+    ECS_REGISTER_COMP(bsf_component_collider_t); 
     ECS_REGISTER_COMP(bsf_component_timer_t); 
     ECS_REGISTER_COMP(bsf_component_projectile_t); 
     ECS_REGISTER_COMP(bsf_component_mob_t); 
@@ -1230,34 +4867,55 @@ GS_API_DECL void bsf_entities_init(struct bsf_t* bsf)
     ECS_REGISTER_COMP(bsf_component_obstacle_t);
     ECS_REGISTER_COMP(bsf_component_item_chest_t);
     ECS_REGISTER_COMP(bsf_component_item_t);
+    ECS_REGISTER_COMP(bsf_component_rest_stats_t);
+    ECS_REGISTER_COMP(bsf_component_rest_system_stats_t);
 
     ECS_REGISTER_COMP(bsf_component_ai_t); 
     ecs_set_component_actions_w_id(bsf->entities.world, ecs_id(bsf_component_ai_t), &(EcsComponentLifecycle) {
-        .dtor = bsf_component_ai_dtor
+        .dtor = bsf_component_ai_dtor,
+        .copy = bsf_component_ai_copy,
+        .move = bsf_component_ai_move
     });
 
     // Register all systems 
 
+    // Refresh collider bounds before any collision tests run this frame
+    ECS_SYSTEM(
+        bsf->entities.world, 
+        bsf_collider_bounds_system, 
+        EcsPreUpdate,
+        bsf_component_collider_t, bsf_component_transform_t
+    );
+
     ECS_SYSTEM(
         bsf->entities.world, 
         bsf_player_system, 
         EcsOnUpdate,
         bsf_component_renderable_t, 
         bsf_component_transform_t, 
-        bsf_component_physics_t, 
+        bsf_component_velocity_t, 
         bsf_component_character_stats_t, 
         bsf_component_health_t,
         bsf_component_gun_t,
         bsf_component_camera_track_t,
         bsf_component_barrel_roll_t,
-        bsf_component_inventory_t
+        bsf_component_inventory_t,
+        bsf_component_collider_t
     );
 
     ECS_SYSTEM(
         bsf->entities.world, 
         bsf_projectile_system, 
         EcsOnUpdate,
-        bsf_component_renderable_t, bsf_component_transform_t, bsf_component_physics_t, bsf_component_timer_t, bsf_component_projectile_t
+        bsf_component_renderable_t, bsf_component_transform_t, bsf_component_velocity_t, bsf_component_timer_t, bsf_component_projectile_t
+    );
+
+    // After integration, only place projectiles touch their collider
+    ECS_SYSTEM(
+        bsf->entities.world, 
+        bsf_projectile_hit_system, 
+        EcsOnUpdate,
+        bsf_component_transform_t, bsf_component_velocity_t, bsf_component_projectile_t, bsf_component_collider_t
     );
 
     ECS_SYSTEM(
@@ -1271,7 +4929,7 @@ GS_API_DECL void bsf_entities_init(struct bsf_t* bsf)
         bsf->entities.world, 
         bsf_physics_debug_draw_system,
         EcsOnUpdate,
-        bsf_component_physics_t, bsf_component_transform_t
+        bsf_component_collider_t, bsf_component_transform_t
     ); 
 
     ECS_SYSTEM(
@@ -1287,11 +4945,12 @@ GS_API_DECL void bsf_entities_init(struct bsf_t* bsf)
         EcsOnUpdate,
         bsf_component_renderable_t, 
         bsf_component_transform_t,
-        bsf_component_physics_t, 
+        bsf_component_velocity_t, 
         bsf_component_health_t, 
         bsf_component_mob_t,
         bsf_component_gun_t,
-        bsf_component_ai_t
+        bsf_component_ai_t,
+        bsf_component_collider_t
     ); 
 
     ECS_SYSTEM(
@@ -1299,7 +4958,7 @@ GS_API_DECL void bsf_entities_init(struct bsf_t* bsf)
         bsf_consumable_system, 
         EcsOnUpdate,
         bsf_component_transform_t, 
-        bsf_component_physics_t, 
+        bsf_component_collider_t, 
         bsf_component_consumable_t
     ); 
 
@@ -1308,7 +4967,7 @@ GS_API_DECL void bsf_entities_init(struct bsf_t* bsf)
         bsf_explosion_system,
         EcsOnUpdate,
         bsf_component_explosion_t,
-        bsf_component_physics_t,
+        bsf_component_collider_t,
         bsf_component_transform_t, 
         bsf_component_timer_t 
     );
@@ -1318,7 +4977,6 @@ GS_API_DECL void bsf_entities_init(struct bsf_t* bsf)
         bsf_obstacle_system,
         EcsOnUpdate,
         bsf_component_transform_t, 
-        bsf_component_physics_t,
         bsf_component_obstacle_t
     );
 
@@ -1327,47 +4985,501 @@ GS_API_DECL void bsf_entities_init(struct bsf_t* bsf)
         bsf_item_chest_system, 
         EcsOnUpdate, 
         bsf_component_transform_t,
-        bsf_component_physics_t,
         bsf_component_item_chest_t,
 		bsf_component_renderable_immediate_t 
     );
 
-    ECS_SYSTEM(
-        bsf->entities.world, 
-        bsf_item_system,
-        EcsOnUpdate, 
-        bsf_component_transform_t,
-        bsf_component_physics_t, 
-        bsf_component_item_t,
-		bsf_component_ai_t 
-    );
+    ECS_SYSTEM(
+        bsf->entities.world, 
+        bsf_item_system,
+        EcsOnUpdate, 
+        bsf_component_transform_t,
+        bsf_component_item_t,
+		bsf_component_ai_t 
+    );
+
+    bsf_rest_init(bsf);
+
+    // Snapshot of registered but otherwise empty world
+    bsf->entities.base = bsf_entities_snapshot_take(bsf, NULL, NULL);
+}
+
+GS_API_DECL void bsf_entities_reset(struct bsf_t* bsf)
+{
+    // Room snapshot references tables that the reset will delete, so release it first
+    bsf_room_snapshot_free(bsf);
+
+    // Restore consumes the snapshot, so retake it
+    bsf_entities_snapshot_restore(bsf, bsf->entities.base);
+    bsf->entities.base = bsf_entities_snapshot_take(bsf, NULL, NULL);
+}
+
+GS_API_DECL ecs_snapshot_t* bsf_entities_snapshot_take(struct bsf_t* bsf, size_t* size, uint32_t* count)
+{
+    ecs_world_t* world = bsf->entities.world;
+
+    bsf->entities.snapshotting = true;
+    ecs_snapshot_t* snapshot = ecs_snapshot_take(world);
+    bsf->entities.snapshotting = false;
+
+    if (!size && !count) {
+        return snapshot;
+    }
+
+    // Tally component data held by snapshot (table counts still match the world at this point)
+    size_t sz = 0;
+    uint32_t cnt = 0;
+    ecs_iter_t it = ecs_snapshot_iter(snapshot);
+    while (ecs_snapshot_next(&it))
+    {
+        if (!it.entities) continue;
+        ecs_type_t type = ecs_table_get_type(it.table);
+        const ecs_id_t* ids = ecs_vector_first(type, ecs_id_t);
+        for (int32_t i = 0; i < ecs_vector_count(type); ++i)
+        {
+            const EcsComponent* c = ecs_get(world, ecs_get_typeid(world, ids[i]), EcsComponent);
+            if (c) sz += (size_t)c->size * it.count;
+        }
+        sz += (sizeof(ecs_entity_t) + sizeof(void*)) * it.count;
+        cnt += it.count;
+    }
+
+    if (size) *size = sz;
+    if (count) *count = cnt;
+
+    return snapshot;
+}
+
+GS_API_DECL void bsf_entities_snapshot_restore(struct bsf_t* bsf, ecs_snapshot_t* snapshot)
+{
+    // Dtors release resources of the current entities, restored entities own the snapshot's hidden renderables
+    ecs_snapshot_restore(bsf->entities.world, snapshot);
+
+    ecs_iter_t it = ecs_term_iter(bsf->entities.world, &(ecs_term_t){.id = ecs_id(bsf_component_renderable_t)});
+    while (ecs_term_next(&it))
+    {
+        bsf_component_renderable_t* rca = ecs_term(&it, bsf_component_renderable_t, 1);
+        for (int32_t i = 0; i < it.count; ++i)
+        {
+            if (!gs_slot_array_handle_valid(bsf->scene.renderables, rca[i].hndl)) continue;
+            bsf_renderable_t* rend = gs_slot_array_getp(bsf->scene.renderables, rca[i].hndl);
+            rend->hidden = false;
+        }
+    }
+}
+
+//=== BSF Rest ===//
+
+GS_API_DECL void bsf_rest_init(struct bsf_t* bsf)
+{
+    if (!bsf->rest.enabled) {
+        return;
+    }
+
+    ecs_world_t* world = bsf->entities.world;
+
+    // Reflection data so REST can serialize values
+    ecs_struct_init(world, &(ecs_struct_desc_t) {
+        .entity.entity = ecs_id(bsf_component_rest_stats_t),
+        .members = {
+            {"entities", ecs_id(ecs_i32_t)},
+            {"tables", ecs_id(ecs_i32_t)},
+            {"systems", ecs_id(ecs_i32_t)},
+            {"fps", ecs_id(ecs_f32_t)},
+            {"frame_time", ecs_id(ecs_f32_t)},
+            {"level", ecs_id(ecs_i32_t)},
+            {"room_cell", ecs_id(ecs_i32_t)},
+            {"room_type", ecs_id(ecs_i32_t)},
+            {"room_mobs", ecs_id(ecs_i32_t)},
+            {"seed", ecs_id(ecs_string_t)}
+        }
+    });
+
+    ecs_struct_init(world, &(ecs_struct_desc_t) {
+        .entity.entity = ecs_id(bsf_component_rest_system_stats_t),
+        .members = {
+            {"time", ecs_id(ecs_f32_t)},
+            {"invoke_count", ecs_id(ecs_i32_t)},
+            {"matched_entities", ecs_id(ecs_i32_t)},
+            {"active", ecs_id(ecs_i32_t)}
+        }
+    });
+
+    // Singleton lives on the component entity, which snapshots skip, so it survives resets and retries
+    ecs_singleton_set(world, bsf_component_rest_stats_t, {.room_cell = -1, .room_type = -1, .seed = bsf->run.seed});
+
+    ecs_measure_frame_time(world, true);
+    ecs_measure_system_time(world, true);
+
+#ifdef FLECS_REST
+    // Http server accepts on its own thread, requests are handled by DequeueRest (at most every 100ms)
+    ecs_singleton_set(world, EcsRest, {.port = bsf->rest.port, .ipaddr = "127.0.0.1"});
+    bsf->rest.dequeue = ecs_lookup_fullpath(world, "flecs.rest.DequeueRest");
+
+    gs_println("REST: http://127.0.0.1:%u/entity/bsf_component_rest_stats_t", 
+        bsf->rest.port ? bsf->rest.port : ECS_REST_DEFAULT_PORT);
+#else
+    gs_println("REST: not available on this target");
+#endif
+}
+
+GS_API_DECL void bsf_rest_update(struct bsf_t* bsf)
+{
+    ecs_world_t* world = bsf->entities.world;
+    if (!bsf->rest.enabled || !world) {
+        return;
+    }
+
+    const float dt = gs_platform_delta_time();
+
+    // Pipeline only runs while playing, keep answering requests from menus
+    if (bsf->state != BSF_STATE_PLAY && bsf->rest.dequeue) {
+        ecs_run(world, bsf->rest.dequeue, dt, NULL);
+    }
+
+    // Sampling walks all tables and systems, so throttle it
+    bsf->rest.timer += dt;
+    if (bsf->rest.timer < BSF_REST_STATS_INTERVAL) {
+        return;
+    }
+    bsf->rest.timer = 0.f;
+
+    // World stats (values are deltas since last sample)
+    ecs_world_stats_t* ws = &bsf->rest.world;
+    ecs_get_world_stats(world, ws);
+    int32_t t = ws->t;
+    const float frames = ws->frame_count_total.rate.avg[t];
+
+    bsf_component_rest_stats_t stats = {
+        .entities = (int32_t)ws->entity_count.avg[t],
+        .tables = (int32_t)ws->table_count.avg[t],
+        .systems = (int32_t)ws->system_count.avg[t],
+        .fps = ws->fps.avg[t],
+        .frame_time = frames > 0.f ? 1000.f * ws->frame_time_total.rate.avg[t] / frames : 0.f,
+        .level = bsf->run.level,
+        .room_cell = -1,
+        .room_type = -1,
+        .seed = bsf->run.seed
+    };
+
+    if (bsf->run.is_playing && gs_slot_array_handle_valid(bsf->run.rooms, bsf->run.room_ids[bsf->run.cell]))
+    {
+        const bsf_room_t* room = gs_slot_array_getp(bsf->run.rooms, bsf->run.room_ids[bsf->run.cell]);
+        stats.room_cell = (int32_t)bsf->run.cell;
+        stats.room_type = (int32_t)room->type;
+        stats.room_mobs = (int32_t)gs_dyn_array_size(room->mobs);
+    }
+
+    ecs_set_ptr(world, ecs_id(bsf_component_rest_stats_t), bsf_component_rest_stats_t, &stats);
+
+    // System stats for all active systems in pipeline
+    ecs_pipeline_stats_t* ps = &bsf->rest.pipeline;
+    if (!ecs_get_pipeline_stats(world, ecs_get_pipeline(world), ps)) {
+        return;
+    }
+
+    const ecs_entity_t* systems = ecs_vector_first(ps->systems, ecs_entity_t);
+    for (int32_t i = 0; i < ecs_vector_count(ps->systems); ++i)
+    {
+        // 0 marks a merge point
+        if (!systems[i]) continue;
+
+        const ecs_system_stats_t* ss = ecs_map_get(ps->system_stats, ecs_system_stats_t, systems[i]);
+        if (!ss) continue;
+
+        t = ss->query_stats.t;
+        const float invokes = ss->invoke_count.rate.avg[t];
+        ecs_set(world, systems[i], bsf_component_rest_system_stats_t, {
+            .time = invokes > 0.f ? 1000.f * ss->time_spent.rate.avg[t] / invokes : 0.f,
+            .invoke_count = (int32_t)invokes,
+            .matched_entities = (int32_t)ss->query_stats.matched_entity_count.avg[t],
+            .active = (int32_t)ss->active.avg[t]
+        });
+    }
+}
+
+//=== BSF Capture ===//
+
+GS_API_DECL void bsf_capture_begin(struct bsf_t* bsf)
+{
+    if (!bsf->capture.path) {
+        return;
+    }
+
+    bsf->capture.fp = fopen(bsf->capture.path, "wb");
+    if (!bsf->capture.fp) {
+        gs_println("Warning: BSF::Unable to open capture file: %s", bsf->capture.path);
+        return;
+    }
+
+    // Opcodes of the opengl backend (gs_graphics_impl.h), keep in sync when gs adds any
+    bsf_capture_code_t ops[] = {
+        {"BEGIN_RENDER_PASS", GS_OPENGL_OP_BEGIN_RENDER_PASS},
+        {"END_RENDER_PASS", GS_OPENGL_OP_END_RENDER_PASS},
+        {"SET_VIEWPORT", GS_OPENGL_OP_SET_VIEWPORT},
+        {"SET_VIEW_SCISSOR", GS_OPENGL_OP_SET_VIEW_SCISSOR},
+        {"CLEAR", GS_OPENGL_OP_CLEAR},
+        {"REQUEST_VERTEX_BUFFER_UPDATE", GS_OPENGL_OP_REQUEST_VERTEX_BUFFER_UPDATE},
+        {"REQUEST_INDEX_BUFFER_UPDATE", GS_OPENGL_OP_REQUEST_INDEX_BUFFER_UPDATE},
+        {"REQUEST_UNIFORM_BUFFER_UPDATE", GS_OPENGL_OP_REQUEST_UNIFORM_BUFFER_UPDATE},
+        {"REQUEST_STORAGE_BUFFER_UPDATE", GS_OPENGL_OP_REQUEST_STORAGE_BUFFER_UPDATE},
+        {"REQUEST_TEXTURE_UPDATE", GS_OPENGL_OP_REQUEST_TEXTURE_UPDATE},
+        {"BIND_PIPELINE", GS_OPENGL_OP_BIND_PIPELINE},
+        {"APPLY_BINDINGS", GS_OPENGL_OP_APPLY_BINDINGS},
+        {"DISPATCH_COMPUTE", GS_OPENGL_OP_DISPATCH_COMPUTE},
+        {"DRAW", GS_OPENGL_OP_DRAW}
+    };
+
+    bsf_capture_code_t binds[] = {
+        {"VERTEX_BUFFER", GS_GRAPHICS_BIND_VERTEX_BUFFER},
+        {"INDEX_BUFFER", GS_GRAPHICS_BIND_INDEX_BUFFER},
+        {"UNIFORM_BUFFER", GS_GRAPHICS_BIND_UNIFORM_BUFFER},
+        {"STORAGE_BUFFER", GS_GRAPHICS_BIND_STORAGE_BUFFER},
+        {"IMAGE_BUFFER", GS_GRAPHICS_BIND_IMAGE_BUFFER},
+        {"UNIFORM", GS_GRAPHICS_BIND_UNIFORM}
+    };
+
+    const bsf_capture_header_t header = {
+        .magic = BSF_CAPTURE_MAGIC,
+        .version = BSF_CAPTURE_VERSION,
+        .size_t_size = sizeof(size_t),
+        .op_count = sizeof(ops) / sizeof(ops[0]),
+        .bind_count = sizeof(binds) / sizeof(binds[0])
+    };
+    fwrite(&header, sizeof(header), 1, bsf->capture.fp);
+    fwrite(ops, sizeof(ops), 1, bsf->capture.fp);
+    fwrite(binds, sizeof(binds), 1, bsf->capture.fp);
+    bsf->capture.frame = 0;
+    gs_println("BSF::Capturing %u play frames to %s", bsf->capture.frames, bsf->capture.path);
+}
+
+GS_API_DECL void bsf_capture_frame(struct bsf_t* bsf, const bsf_render_frame_t* frame)
+{
+    const gs_command_buffer_t* streams[] = {&frame->cb, &frame->overlay};
+    const uint32_t stream_count = sizeof(streams) / sizeof(streams[0]);
+
+    const bsf_capture_frame_t fh = {
+        .frame = bsf->capture.frame,
+        .encode_ms = frame->stats.encode_ms,
+        .draws = frame->stats.queue.draws,
+        .instances = frame->stats.queue.instances,
+        .pipeline_binds = frame->stats.queue.pipeline_binds,
+        .mesh_binds = frame->stats.queue.mesh_binds,
+        .stream_count = stream_count
+    };
+    fwrite(&fh, sizeof(fh), 1, bsf->capture.fp);
+
+    for (uint32_t i = 0; i < stream_count; ++i)
+    {
+        const uint32_t info[2] = {streams[i]->num_commands, streams[i]->commands.size};
+        fwrite(info, sizeof(info), 1, bsf->capture.fp);
+        fwrite(streams[i]->commands.data, 1, streams[i]->commands.size, bsf->capture.fp);
+    }
+
+    if (++bsf->capture.frame >= bsf->capture.frames) {
+        bsf_capture_end(bsf);
+        gs_quit();
+    }
+}
+
+GS_API_DECL void bsf_capture_end(struct bsf_t* bsf)
+{
+    if (!bsf->capture.fp) {
+        return;
+    }
+
+    // Patch frame count into header
+    fseek(bsf->capture.fp, offsetof(bsf_capture_header_t, frames), SEEK_SET);
+    fwrite(&bsf->capture.frame, sizeof(uint32_t), 1, bsf->capture.fp);
+    fclose(bsf->capture.fp);
+    bsf->capture.fp = NULL;
+    gs_println("BSF::Captured %u frames to %s", bsf->capture.frame, bsf->capture.path);
 }
 
 //=== BSF Components ===// 
 
+GS_API_DECL void bsf_component_renderable_ctor(ecs_world_t* world, ecs_entity_t comp, const ecs_entity_t* ent, void* ptr, size_t sz, int32_t count, void* ctx)
+{
+    // Slot 0 is valid, so start out with an invalid handle
+    bsf_component_renderable_t* rend = (bsf_component_renderable_t*)ptr;
+    for (int32_t i = 0; i < count; ++i) {
+        rend[i].hndl = UINT32_MAX;
+    }
+}
+
 GS_API_DECL void bsf_component_renderable_dtor(ecs_world_t* world, ecs_entity_t comp, const ecs_entity_t* ent, void* ptr, size_t sz, int32_t count, void* ctx)
 {
+    // Release all renderable slots for the batch
     bsf_t* bsf = gs_user_data(bsf_t);
-    bsf_component_renderable_t* rend = ecs_get(world, *ent, bsf_component_renderable_t);
-    bsf_graphics_scene_renderable_destroy(&bsf->scene, rend->hndl);
+    bsf_component_renderable_t* rend = (bsf_component_renderable_t*)ptr;
+    for (int32_t i = 0; i < count; ++i) {
+        bsf_graphics_scene_renderable_destroy(&bsf->scene, rend[i].hndl);
+    }
 } 
 
+GS_API_DECL void bsf_component_renderable_copy(ecs_world_t* world, ecs_entity_t comp, const ecs_entity_t* dst_ent, const ecs_entity_t* src_ent, 
+        void* dst_ptr, const void* src_ptr, size_t sz, int32_t count, void* ctx)
+{
+    bsf_t* bsf = gs_user_data(bsf_t);
+    bsf_component_renderable_t* dst = (bsf_component_renderable_t*)dst_ptr;
+    const bsf_component_renderable_t* src = (const bsf_component_renderable_t*)src_ptr;
+    for (int32_t i = 0; i < count; ++i)
+    {
+        // Setting over an existing renderable releases its slot
+        if (dst[i].hndl != src[i].hndl) {
+            bsf_graphics_scene_renderable_destroy(&bsf->scene, dst[i].hndl);
+        }
+        dst[i] = src[i];
+
+        // Sets hand over the handle, snapshots (hidden) and instances/clones of another entity get their own renderable
+        const bool32 dup = bsf->entities.snapshotting || (dst_ent && src_ent && dst_ent[i] != src_ent[i]);
+        if (!dup || !gs_slot_array_handle_valid(bsf->scene.renderables, src[i].hndl)) {
+            continue;
+        }
+        bsf_renderable_t rend = gs_slot_array_get(bsf->scene.renderables, src[i].hndl);
+        rend.hidden = bsf->entities.snapshotting;
+        dst[i].hndl = gs_slot_array_insert(bsf->scene.renderables, rend);
+    }
+}
+
+GS_API_DECL void bsf_component_renderable_move(ecs_world_t* world, ecs_entity_t comp, const ecs_entity_t* dst_ent, const ecs_entity_t* src_ent, 
+        void* dst_ptr, void* src_ptr, size_t sz, int32_t count, void* ctx)
+{
+    // Handle follows the entity across tables, source is left invalid for its dtor
+    bsf_t* bsf = gs_user_data(bsf_t);
+    bsf_component_renderable_t* dst = (bsf_component_renderable_t*)dst_ptr;
+    bsf_component_renderable_t* src = (bsf_component_renderable_t*)src_ptr;
+    for (int32_t i = 0; i < count; ++i)
+    {
+        if (dst[i].hndl != src[i].hndl) {
+            bsf_graphics_scene_renderable_destroy(&bsf->scene, dst[i].hndl);
+        }
+        dst[i] = src[i];
+        src[i].hndl = UINT32_MAX;
+    }
+}
+
 //=== BSF AI ===// 
 
 GS_API_DECL void bsf_component_ai_dtor( ecs_world_t* world, ecs_entity_t comp, const ecs_entity_t* ent, void* ptr, size_t sz, int32_t count, void* ctx )
 {
-    gs_println("DESTROY AI");
-    bsf_t* bsf = gs_user_data(bsf_t);
-    bsf_component_ai_t* ai = ecs_get(world, *ent, bsf_component_ai_t);
-	gs_ai_bt_free(&ai->bt);
+    // Free all behavior trees for the batch
+    bsf_component_ai_t* ai = (bsf_component_ai_t*)ptr;
+    for (int32_t i = 0; i < count; ++i) {
+        gs_ai_bt_free(&ai[i].bt);
+    }
+}
+
+GS_API_DECL void bsf_component_ai_copy(ecs_world_t* world, ecs_entity_t comp, const ecs_entity_t* dst_ent, const ecs_entity_t* src_ent, 
+        void* dst_ptr, const void* src_ptr, size_t sz, int32_t count, void* ctx)
+{
+    // Behavior tree state is never shared, copies start with a fresh tree
+    bsf_component_ai_t* dst = (bsf_component_ai_t*)dst_ptr;
+    const bsf_component_ai_t* src = (const bsf_component_ai_t*)src_ptr;
+    for (int32_t i = 0; i < count; ++i)
+    {
+        if (&dst[i] == &src[i]) continue;
+        gs_ai_bt_free(&dst[i].bt);
+        dst[i] = src[i];
+        memset(&dst[i].bt, 0, sizeof(gs_ai_bt_t));
+    }
+}
+
+GS_API_DECL void bsf_component_ai_move(ecs_world_t* world, ecs_entity_t comp, const ecs_entity_t* dst_ent, const ecs_entity_t* src_ent, 
+        void* dst_ptr, void* src_ptr, size_t sz, int32_t count, void* ctx)
+{
+    // Tree state follows the entity across tables, source is left with an empty tree for its dtor
+    bsf_component_ai_t* dst = (bsf_component_ai_t*)dst_ptr;
+    bsf_component_ai_t* src = (bsf_component_ai_t*)src_ptr;
+    for (int32_t i = 0; i < count; ++i)
+    {
+        if (&dst[i] == &src[i]) continue;
+        gs_ai_bt_free(&dst[i].bt);
+        dst[i] = src[i];
+        memset(&src[i].bt, 0, sizeof(gs_ai_bt_t));
+    }
 }
 
 //=== BSF Physics ===// 
 
-GS_API_DECL gs_contact_info_t bsf_component_physics_collide(const bsf_component_physics_t* c0, 
-        const gs_vqs* xform0, const bsf_component_physics_t* c1, const gs_vqs* xform1)
+GS_API_DECL void bsf_component_collider_bake(bsf_component_collider_t* cc, const gs_vqs* xform)
+{
+    // Moved only, bounds follow the translation
+    if (cc->bounds.r > 0.f && !memcmp(&cc->rotation, &xform->rotation, sizeof(gs_quat)) && 
+        !memcmp(&cc->scale, &xform->scale, sizeof(gs_vec3)))
+    {
+        cc->bounds.c = gs_vec3_add(xform->translation, cc->offset);
+        return;
+    }
+
+    const bsf_physics_collider_t* c = &cc->collider;
+    gs_vec3 center = gs_v3s(0.f);
+    float radius = 0.f;
+
+    // Local bounding sphere of shape
+    switch (c->type)
+    {
+        case BSF_COLLIDER_AABB:
+        {
+            center = gs_vec3_scale(gs_vec3_add(c->shape.aabb.min, c->shape.aabb.max), 0.5f);
+            radius = gs_vec3_len(gs_vec3_sub(c->shape.aabb.max, center));
+        } break;
+
+        case BSF_COLLIDER_SPHERE:
+        {
+            center = c->shape.sphere.c;
+            radius = c->shape.sphere.r;
+        } break;
+
+        // Conservative, covers height along either direction from base
+        case BSF_COLLIDER_CYLINDER:
+        {
+            center = c->shape.cylinder.base;
+            radius = sqrtf(c->shape.cylinder.r * c->shape.cylinder.r + c->shape.cylinder.height * c->shape.cylinder.height);
+        } break;
+
+        case BSF_COLLIDER_CONE:
+        {
+            center = c->shape.cone.base;
+            radius = sqrtf(c->shape.cone.r * c->shape.cone.r + c->shape.cone.height * c->shape.cone.height);
+        } break;
+    }
+
+    // Bake into world space
+    gs_vqs xf = gs_vqs_absolute_transform(&c->xform, xform);
+    const float smax = gs_max(fabsf(xf.scale.x), gs_max(fabsf(xf.scale.y), fabsf(xf.scale.z)));
+    cc->bounds.c = gs_vec3_add(xf.translation, gs_quat_rotate(xf.rotation, gs_vec3_mul(xf.scale, center)));
+    cc->bounds.r = radius * smax;
+    cc->offset = gs_vec3_sub(cc->bounds.c, xform->translation);
+    cc->rotation = xform->rotation;
+    cc->scale = xform->scale;
+}
+
+GS_API_DECL void bsf_collider_bounds_system(ecs_iter_t* it)
+{
+    bsf_component_collider_t* cca = ecs_term(it, bsf_component_collider_t, 1);
+    bsf_component_transform_t* tca = ecs_term(it, bsf_component_transform_t, 2);
+
+    for (uint32_t i = 0; i < it->count; ++i)
+    {
+        bsf_component_collider_bake(&cca[i], &tca[i].xform);
+    }
+}
+
+GS_API_DECL gs_contact_info_t bsf_component_physics_collide(const bsf_component_collider_t* c0, 
+        const gs_vqs* xform0, const bsf_component_collider_t* c1, const gs_vqs* xform1)
 { 
     gs_contact_info_t res = {0}; 
+
+    // Early out on baked bounds before running narrow phase
+    if (c0->bounds.r > 0.f && c1->bounds.r > 0.f)
+    {
+        const float rs = c0->bounds.r + c1->bounds.r;
+        if (gs_vec3_dist2(c0->bounds.c, c1->bounds.c) > rs * rs) {
+            return res;
+        }
+    }
+
     gs_vqs xf0 = gs_vqs_absolute_transform(&c0->collider.xform, xform0);
     gs_vqs xf1 = gs_vqs_absolute_transform(&c1->collider.xform, xform1); 
 
@@ -1425,6 +5537,160 @@ GS_API_DECL gs_contact_info_t bsf_component_physics_collide(const bsf_component_
     return res;
 }
 
+//=== BSF Particles ===//
+
+static const bsf_particle_emitter_t bsf_particle_emitters[BSF_PARTICLE_EFFECT_COUNT] = {
+    [BSF_PARTICLE_EXPLOSION] = {
+        .count = 48, .speed = {2.f, 8.f}, .life = {0.4f, 1.f}, .size = {0.2f, 0.6f}, .gravity = 0.f, .drag = 3.f,
+        .color_start = {1.f, 0.9f, 0.4f, 1.f}, .color_end = {0.5f, 0.05f, 0.f, 1.f}
+    },
+    [BSF_PARTICLE_IMPACT] = {
+        .count = 8, .speed = {4.f, 10.f}, .life = {0.1f, 0.3f}, .size = {0.05f, 0.12f}, .gravity = 9.8f, .drag = 1.f,
+        .color_start = {1.f, 1.f, 0.8f, 1.f}, .color_end = {1.f, 0.5f, 0.1f, 1.f}
+    },
+    [BSF_PARTICLE_BOSS_DEATH] = {
+        .count = 512, .speed = {5.f, 40.f}, .life = {1.f, 3.f}, .size = {0.5f, 2.f}, .gravity = 2.f, .drag = 1.5f,
+        .color_start = {1.f, 1.f, 0.7f, 1.f}, .color_end = {0.6f, 0.1f, 0.3f, 1.f}
+    },
+    [BSF_PARTICLE_TRAIL] = {
+        .count = 1, .speed = {0.f, 0.5f}, .life = {0.3f, 0.5f}, .size = {0.1f, 0.25f}, .gravity = 0.f, .drag = 2.f,
+        .color_start = {0.9f, 0.9f, 0.9f, 1.f}, .color_end = {0.2f, 0.2f, 0.2f, 1.f}
+    }
+};
+
+GS_API_DECL void bsf_particles_init(bsf_particles_t* ps)
+{
+    float** arrays[] = {&ps->px, &ps->py, &ps->pz, &ps->vx, &ps->vy, &ps->vz, &ps->gravity, &ps->drag, &ps->life, &ps->inv_life, &ps->size};
+    for (uint32_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); ++i) {
+        *arrays[i] = gs_malloc(BSF_PARTICLE_MAX * sizeof(float));
+        memset(*arrays[i], 0, BSF_PARTICLE_MAX * sizeof(float));
+    }
+    ps->effect = gs_malloc(BSF_PARTICLE_MAX);
+    ps->count = 0;
+    ps->rand = gs_rand_seed(gs_hash_str64("particles"));
+}
+
+GS_API_DECL void bsf_particles_emit(bsf_particles_t* ps, bsf_particle_effect effect, gs_vec3 position, float scale)
+{
+    const bsf_particle_emitter_t* em = &bsf_particle_emitters[effect];
+    for (uint32_t n = 0; n < em->count && ps->count < BSF_PARTICLE_MAX; ++n)
+    {
+        // Uniform direction on the unit sphere
+        const float z = gs_rand_gen_range(&ps->rand, -1.f, 1.f);
+        const float a = gs_rand_gen_range(&ps->rand, 0.f, 2.f * GS_PI);
+        const float r = sqrtf(1.f - z * z);
+        const float speed = gs_rand_gen_range(&ps->rand, em->speed[0], em->speed[1]) * scale;
+        const float life = gs_rand_gen_range(&ps->rand, em->life[0], em->life[1]);
+
+        const uint32_t i = ps->count++;
+        ps->px[i] = position.x;
+        ps->py[i] = position.y;
+        ps->pz[i] = position.z;
+        ps->vx[i] = r * cosf(a) * speed;
+        ps->vy[i] = r * sinf(a) * speed;
+        ps->vz[i] = z * speed;
+        ps->gravity[i] = em->gravity;
+        ps->drag[i] = em->drag;
+        ps->life[i] = life;
+        ps->inv_life[i] = 1.f / life;
+        ps->size[i] = gs_rand_gen_range(&ps->rand, em->size[0], em->size[1]) * scale;
+        ps->effect[i] = (uint8_t)effect;
+    }
+}
+
+GS_API_DECL void bsf_particles_update(bsf_particles_t* ps, float dt)
+{
+    uint32_t i = 0;
+
+#ifdef BSF_SIMD_SSE
+    // v = (v - g * dt) * max(0, 1 - drag * dt), p += v * dt
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 one = _mm_set1_ps(1.f);
+    for (; i + 4 <= ps->count; i += 4)
+    {
+        const __m128 damp = _mm_max_ps(_mm_setzero_ps(), _mm_sub_ps(one, _mm_mul_ps(_mm_loadu_ps(&ps->drag[i]), vdt)));
+        const __m128 vx = _mm_mul_ps(_mm_loadu_ps(&ps->vx[i]), damp);
+        const __m128 vy = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&ps->vy[i]), _mm_mul_ps(_mm_loadu_ps(&ps->gravity[i]), vdt)), damp);
+        const __m128 vz = _mm_mul_ps(_mm_loadu_ps(&ps->vz[i]), damp);
+        _mm_storeu_ps(&ps->vx[i], vx);
+        _mm_storeu_ps(&ps->vy[i], vy);
+        _mm_storeu_ps(&ps->vz[i], vz);
+        _mm_storeu_ps(&ps->px[i], _mm_add_ps(_mm_loadu_ps(&ps->px[i]), _mm_mul_ps(vx, vdt)));
+        _mm_storeu_ps(&ps->py[i], _mm_add_ps(_mm_loadu_ps(&ps->py[i]), _mm_mul_ps(vy, vdt)));
+        _mm_storeu_ps(&ps->pz[i], _mm_add_ps(_mm_loadu_ps(&ps->pz[i]), _mm_mul_ps(vz, vdt)));
+        _mm_storeu_ps(&ps->life[i], _mm_sub_ps(_mm_loadu_ps(&ps->life[i]), vdt));
+    }
+#endif
+
+    for (; i < ps->count; ++i)
+    {
+        const float damp = gs_max(0.f, 1.f - ps->drag[i] * dt);
+        ps->vx[i] *= damp;
+        ps->vy[i] = (ps->vy[i] - ps->gravity[i] * dt) * damp;
+        ps->vz[i] *= damp;
+        ps->px[i] += ps->vx[i] * dt;
+        ps->py[i] += ps->vy[i] * dt;
+        ps->pz[i] += ps->vz[i] * dt;
+        ps->life[i] -= dt;
+    }
+
+    // Dead particles are replaced by the last live one to keep the pool packed
+    for (i = 0; i < ps->count;)
+    {
+        if (ps->life[i] > 0.f) {
+            ++i;
+            continue;
+        }
+        const uint32_t last = --ps->count;
+        ps->px[i] = ps->px[last];
+        ps->py[i] = ps->py[last];
+        ps->pz[i] = ps->pz[last];
+        ps->vx[i] = ps->vx[last];
+        ps->vy[i] = ps->vy[last];
+        ps->vz[i] = ps->vz[last];
+        ps->gravity[i] = ps->gravity[last];
+        ps->drag[i] = ps->drag[last];
+        ps->life[i] = ps->life[last];
+        ps->inv_life[i] = ps->inv_life[last];
+        ps->size[i] = ps->size[last];
+        ps->effect[i] = ps->effect[last];
+    }
+}
+
+GS_API_DECL void bsf_particles_extract(const bsf_particles_t* ps, gs_dyn_array(bsf_render_instance_t)* instances)
+{
+    gs_dyn_array_clear(*instances);
+    for (uint32_t i = 0; i < ps->count; ++i)
+    {
+        // Shrink out and fade to end color over lifetime
+        const bsf_particle_emitter_t* em = &bsf_particle_emitters[ps->effect[i]];
+        const float t = gs_clamp(1.f - ps->life[i] * ps->inv_life[i], 0.f, 1.f);
+        bsf_render_instance_t inst = {.model = gs_mat4_scalev(gs_v3s(ps->size[i] * (1.f - t)))};
+        inst.model.elements[12] = ps->px[i];
+        inst.model.elements[13] = ps->py[i];
+        inst.model.elements[14] = ps->pz[i];
+        for (uint32_t c = 0; c < 4; ++c) {
+            inst.tint.xyzw[c] = gs_interp_linear(em->color_start[c], em->color_end[c], t);
+        }
+        gs_dyn_array_push(*instances, inst);
+    }
+}
+
+GS_API_DECL void bsf_particles_clear(bsf_particles_t* ps)
+{
+    ps->count = 0;
+}
+
+GS_API_DECL void bsf_particles_free(bsf_particles_t* ps)
+{
+    float* arrays[] = {ps->px, ps->py, ps->pz, ps->vx, ps->vy, ps->vz, ps->gravity, ps->drag, ps->life, ps->inv_life, ps->size};
+    for (uint32_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); ++i) {
+        gs_free(arrays[i]);
+    }
+    gs_free(ps->effect);
+    memset(ps, 0, sizeof(bsf_particles_t));
+}
+
 //=== BSF Exposion ===// 
 
 GS_API_DECL ecs_entity_t bsf_explosion_create(struct bsf_t* bsf, ecs_world_t* world, gs_vqs* xform, bsf_owner_type owner)
@@ -1433,9 +5699,7 @@ GS_API_DECL ecs_entity_t bsf_explosion_create(struct bsf_t* bsf, ecs_world_t* wo
 
     ecs_set(world, b, bsf_component_transform_t, {.xform = *xform});
 
-    ecs_set(world, b, bsf_component_physics_t, {
-        .velocity = gs_v3s(0.f), 
-        .speed = 0.f,
+    ecs_set(world, b, bsf_component_collider_t, {
         .collider = {
             .xform = gs_vqs_default(),
             .type = BSF_COLLIDER_SPHERE,
@@ -1447,9 +5711,10 @@ GS_API_DECL ecs_entity_t bsf_explosion_create(struct bsf_t* bsf, ecs_world_t* wo
     }); 
 
     bsf_camera_shake(bsf, &bsf->scene.camera, 0.3f);
+    bsf_particles_emit(&bsf->particles, BSF_PARTICLE_EXPLOSION, xform->translation, gs_max(1.f, sqrtf(xform->scale.x)));
 
     // Play sound
-    bsf_play_sound(bsf, "audio.explosion", 0.1f);
+    bsf_play_sound(bsf, bsf->assets.hndl.audio_explosion, 0.1f);
 
     ecs_set(world, b, bsf_component_timer_t, {.max = 1.f}); 
     ecs_set(world, b, bsf_component_explosion_t, {.owner = owner});
@@ -1463,7 +5728,7 @@ GS_API_DECL void bsf_explosion_system(ecs_iter_t* it)
     const float t = gs_platform_elapsed_time();
     const float dt = gs_platform_delta_time(); 
     bsf_component_explosion_t* eca = ecs_term(it, bsf_component_explosion_t, 1);
-    bsf_component_physics_t* pca = ecs_term(it, bsf_component_physics_t, 2);
+    bsf_component_collider_t* cca = ecs_term(it, bsf_component_collider_t, 2);
     bsf_component_transform_t* tca = ecs_term(it, bsf_component_transform_t, 3); 
     bsf_component_timer_t* kca = ecs_term(it, bsf_component_timer_t, 4); 
     const bsf_room_t* room = gs_slot_array_getp(bsf->run.rooms, bsf->run.room_ids[bsf->run.cell]);
@@ -1474,7 +5739,7 @@ GS_API_DECL void bsf_explosion_system(ecs_iter_t* it)
     {
         ecs_entity_t e = it->entities[i];
         bsf_component_explosion_t* ec = &eca[i];
-        bsf_component_physics_t* pc = &pca[i];
+        bsf_component_collider_t* cc = &cca[i];
         bsf_component_transform_t* tc = &tca[i];
         bsf_component_timer_t* kc = &kca[i]; 
 
@@ -1482,6 +5747,7 @@ GS_API_DECL void bsf_explosion_system(ecs_iter_t* it)
         kc->time += dt;
 
         tc->xform.scale = gs_vec3_add(tc->xform.scale, gs_v3s(0.1f));
+        bsf_component_collider_bake(cc, &tc->xform);
 
         if (kc->time >= kc->max) 
         {
@@ -1496,9 +5762,9 @@ GS_API_DECL void bsf_explosion_system(ecs_iter_t* it)
 				{
 					ecs_entity_t mob = room->mobs[m]; 
 					bsf_component_transform_t* mtc = ecs_get(bsf->entities.world, mob, bsf_component_transform_t);
-					bsf_component_physics_t* mpc = ecs_get(bsf->entities.world, mob, bsf_component_physics_t); 
-					if (!mtc || !mpc) continue;
-					gs_contact_info_t res = bsf_component_physics_collide(pc, &tc->xform, mpc, &mtc->xform); 
+					bsf_component_collider_t* mcc = ecs_get(bsf->entities.world, mob, bsf_component_collider_t); 
+					if (!mtc || !mcc) continue;
+					gs_contact_info_t res = bsf_component_physics_collide(cc, &tc->xform, mcc, &mtc->xform); 
 
 					if (res.hit)
 					{ 
@@ -1523,241 +5789,75 @@ GS_API_DECL void bsf_physics_debug_draw_system(ecs_iter_t* it)
     const float t = gs_platform_elapsed_time();
     const float dt = gs_platform_delta_time(); 
     const gs_vec2 fbs = gs_platform_framebuffer_sizev(gs_platform_main_window());
-    bsf_component_physics_t* pca = ecs_term(it, bsf_component_physics_t, 1);
+    bsf_component_collider_t* cca = ecs_term(it, bsf_component_collider_t, 1);
     bsf_component_transform_t* tca = ecs_term(it, bsf_component_transform_t, 2);
 
 	gsi_defaults(gsi);
 	gsi_depth_enabled(gsi, true);
 	gsi_blend_enabled(gsi, true);
-    gsi_camera(gsi, &bsf->scene.camera.cam, (uint32_t)fbs.x, (uint32_t)fbs.y);
-    for (uint32_t i = 0; i < it->count; ++i)
-    {
-        ecs_entity_t e = it->entities[i];
-        bsf_component_physics_t* pc = &pca[i];
-        bsf_component_transform_t* tc = &tca[i];
-
-        gsi_push_matrix(gsi, GSI_MATRIX_MODELVIEW);
-        {
-			gs_vqs xform = gs_vqs_absolute_transform(&pc->collider.xform, &tc->xform);
-            gsi_mul_matrix(gsi, gs_vqs_to_mat4(&xform));
-            switch (pc->collider.type)
-            {
-                default:
-                case BSF_COLLIDER_AABB:
-                {
-                    gs_aabb_t* s = &pc->collider.shape.aabb;
-                    gs_vec3 hd = gs_vec3_scale(gs_vec3_sub(s->max, s->min), 0.5f);
-                    gs_vec3 c = gs_vec3_add(s->min, hd);
-                    gsi_box(gsi, c.x, c.y, c.z, hd.x, hd.y, hd.z, 255, 255, 255, 255, GS_GRAPHICS_PRIMITIVE_LINES);
-                } break;
-
-                case BSF_COLLIDER_SPHERE:
-                {
-                    gs_sphere_t* s = &pc->collider.shape.sphere;
-                    gsi_sphere(gsi, s->c.x, s->c.y, s->c.z, s->r, 255, 255, 255, 255, GS_GRAPHICS_PRIMITIVE_LINES); 
-                } break; 
-
-                case BSF_COLLIDER_CYLINDER:
-                {
-                    gs_cylinder_t* s = &pc->collider.shape.cylinder;
-                    gsi_cylinder(gsi, s->base.x, s->base.y, s->base.z, s->r, s->r, s->height, 16, 255, 255, 255, 255, GS_GRAPHICS_PRIMITIVE_LINES); 
-                } break; 
-
-                case BSF_COLLIDER_CONE:
-                { 
-                    gs_cone_t* s = &pc->collider.shape.cone;
-                    gsi_cone(gsi, s->base.x, s->base.y, s->base.z, s->r, s->height, 16, 255, 255, 255, 255, GS_GRAPHICS_PRIMITIVE_LINES);
-                } break;
-            }
-        }
-        gsi_pop_matrix(gsi);
-    }
-} 
-
-GS_API_DECL void bsf_renderable_immediate_system(ecs_iter_t* it)
-{
-    bsf_t* bsf = gs_user_data(bsf_t); 
-    gs_immediate_draw_t* gsi = &bsf->gs.gsi;
-    const float t = gs_platform_elapsed_time();
-    const float dt = gs_platform_delta_time(); 
-    const gs_platform_input_t* input = &gs_subsystem(platform)->input;
-    const gs_platform_gamepad_t* gp = &input->gamepads[0];
-    const gs_vec2 fbs = gs_platform_framebuffer_sizev(gs_platform_main_window());
-    bsf_component_renderable_immediate_t* rca = ecs_term(it, bsf_component_renderable_immediate_t, 1);
-    bsf_component_transform_t* tca = ecs_term(it, bsf_component_transform_t, 2);
-
-    gsi_camera3D(gsi, (uint32_t)fbs.x, (uint32_t)fbs.y);
-    for (uint32_t i = 0; i < it->count; ++i)
-    { 
-		bsf_component_renderable_immediate_t* rc = &rca[i];
-		bsf_component_transform_t* tc = &tca[i];
-
-        if (rc->shape == BSF_SHAPE_ROOM) continue;
-                
-        rc->model = gs_vqs_to_mat4(&tc->xform); 
-        const gs_color_t* col = &rc->color;
-        gs_gfxt_pipeline_t* pip = gs_gfxt_material_get_pipeline(rc->material);
-        gs_mat4 mvp = {0}; 
-
-        if (rc->opt & BSF_RENDERABLE_IMMEDIATE_BLEND_ENABLE)     gsi_blend_enabled(gsi, true);
-        if (rc->opt & BSF_RENDERABLE_IMMEDIATE_DEPTH_ENABLE)     gsi_depth_enabled(gsi, true);
-        if (rc->opt & BSF_RENDERABLE_IMMEDIATE_FACE_CULL_ENABLE) gsi_face_cull_enabled(gsi, true);
-
-        gsi_push_matrix(gsi, GSI_MATRIX_MODELVIEW);
-        {
-            gsi_vattr_list_mesh(gsi, pip->mesh_layout, gs_dyn_array_size(pip->mesh_layout) * sizeof(gs_gfxt_mesh_layout_t)); 
-            gsi_load_matrix(gsi, rc->model);
-
-            switch (rc->shape)
-            {
-                case BSF_SHAPE_RECT:
-                {
-                    gsi_rectvd(gsi, gs_v2s(-0.5f), gs_v2s(0.5f), gs_v2s(0.f), gs_v2s(1.f), *col, pip->desc.raster.primitive);
-                } break;
-
-                case BSF_SHAPE_SPHERE:
-                {
-                    gsi_sphere(gsi, 0.f, 0.f, 0.f, 0.5, col->r, col->g, col->b, col->a, pip->desc.raster.primitive); 
-                } break;
-
-                case BSF_SHAPE_BOX:
-                {
-                    gsi_box(gsi, 0.f, 0.f, 0.f, 0.5f, 0.5f, 0.5f, col->r, col->g, col->b, col->a, pip->desc.raster.primitive);
-                } break;
-
-                case BSF_SHAPE_CONE:
-                {
-                    gsi_cone(gsi, 0.f, 0.f, 0.f, 0.5f, 1.f, 16, col->r, col->g, col->b, col->a, pip->desc.raster.primitive);
-                } break;
-
-                case BSF_SHAPE_CYLINDER:
-                {
-                    gsi_cylinder(gsi, 0.f, 0.f, 0.f, 0.5f, 0.5f, 1.f, 16, col->r, col->g, col->b, col->a, pip->desc.raster.primitive);
-                } break;
-
-                case BSF_SHAPE_CROSS:
-                {
-                    gs_aabb_t aabb = {
-                        .min = gs_v3s(-0.5f),
-                        .max = gs_v3s(0.5f)
-                    };
-                    gs_vec3 hd = gs_vec3_scale(gs_vec3_sub(aabb.max, aabb.min), 0.5f);
-                    gs_vec3 c = gs_vec3_add(aabb.min, hd);
-                    gsi_box(gsi, c.x, c.y, c.z, hd.x * 0.2f, hd.y, hd.z * 0.2f, col->r, col->g, col->b, col->a, pip->desc.raster.primitive);
-                    gsi_box(gsi, c.x, c.y, c.z, hd.x, hd.y * 0.2f, hd.z * 0.2f, col->r, col->g, col->b, col->a, pip->desc.raster.primitive);
-
-                } break;
-            }
-
-            mvp = gsi_get_mvp_matrix(gsi); 
-        }
-        gs_gfxt_texture_t tex = rc->texture ? *rc->texture : GSI()->tex_default;
-        gsi_pop_matrix_ex(gsi, false);
-		gs_mat4 vp = gs_camera_get_view_projection(&bsf->scene.camera.cam, fbs.x, fbs.y);
-		mvp = gs_mat4_mul(vp, rc->model);
-        gs_gfxt_material_set_uniform(rc->material, "u_mvp", &mvp);
-        gs_gfxt_material_set_uniform(rc->material, "u_tex", &tex);
-        gs_gfxt_material_bind(&gsi->commands, rc->material);
-        gs_gfxt_material_bind_uniforms(&gsi->commands, rc->material);
-        gsi_flush(gsi); 
-    } 
-
-    // World 
-    gsi_defaults(gsi);
-    gsi_blend_enabled(gsi, true);
-    gsi_depth_enabled(gsi, true);
-    gsi_camera(gsi, &bsf->scene.camera, (uint32_t)fbs.x, (uint32_t)fbs.y);
-    bsf_room_t* room = gs_slot_array_getp(bsf->run.rooms, bsf->run.room_ids[bsf->run.cell]);
-    switch (room->movement_type)
-    {
-        case BSF_MOVEMENT_FREE_RANGE:
-        {
-            const float sz = 2000;
-            const float sx = 2000;
-            const float sy = 300; 
-            const float step = 20.f;
-            gs_color_t c0 = gs_color(6, 59, 0, 255); 
-            gs_color_t c1 = gs_color(14, 255, 0, 255); 
-            for (float r = -sz; r <= sz; r += step)
-            {
-                const float ct = gs_map_range(-sz, sz, 0.f, 1.f, r);
-                gs_color_t color = gs_color(
-                    (uint8_t)(255.f * gs_interp_smoothstep((float)c0.r / 255.f, (float)c1.r / 255.f, ct)),
-                    (uint8_t)(255.f * gs_interp_smoothstep((float)c0.g / 255.f, (float)c1.g / 255.f, ct)), 
-                    (uint8_t)(255.f * gs_interp_smoothstep((float)c0.b / 255.f, (float)c1.b / 255.f, ct)),
-                    (uint8_t)(255.f * gs_interp_smoothstep((float)c0.a / 255.f, (float)c1.a / 255.f, ct))
-                );
-
-                gs_vec3 s = gs_v3(-sx, 0.f, r);
-                gsi_rect3Dv(gsi, s, gs_v3(2 * sx, 0.f, r + step), gs_v2s(0.f), gs_v2s(1.f), color, GS_GRAPHICS_PRIMITIVE_TRIANGLES);
-            }
-        } break;
-
-        case BSF_MOVEMENT_RAIL:
-        {
-            // All the ground
-            const float sz = 150;
-            const float sx = 500;
-            const float sy = 100;
-            const float step = 20.f;
-            const float speed_mod = gp->axes[GS_PLATFORM_JOYSTICK_AXIS_RTRIGGER] >= 0.4f || gs_platform_key_down(GS_KEYCODE_LEFT_SHIFT) ? 3.f : 1.f;
-            const float zoff = fmod(t * 0.02f * speed_mod, step);
-            gs_color_t c0 = gs_color(6, 59, 0, 255); 
-            gs_color_t c1 = gs_color(14, 255, 0, 255); 
-            for (float r = -sz * 0.5f; r <= sz; r += step)
-            { 
-                for (float c = -80; c < 80; c += step)
-                {
-                    // Draw columns
-                    gsi_box(gsi, c, 0.f, r + zoff, 0.1f, 0.1f, 0.1f, 255, 255, 255, 255, GS_GRAPHICS_PRIMITIVE_TRIANGLES);
-                }
-            }
-
-            for (float r = -sz; r <= sz; r += step)
-            {
-                const float ct = gs_map_range(-sz, sz, 0.f, 1.f, r);
-                gs_color_t color = gs_color(
-                    (uint8_t)(255.f * gs_interp_smoothstep((float)c0.r / 255.f, (float)c1.r / 255.f, ct)),
-                    (uint8_t)(255.f * gs_interp_smoothstep((float)c0.g / 255.f, (float)c1.g / 255.f, ct)), 
-                    (uint8_t)(255.f * gs_interp_smoothstep((float)c0.b / 255.f, (float)c1.b / 255.f, ct)),
-                    (uint8_t)(255.f * gs_interp_smoothstep((float)c0.a / 255.f, (float)c1.a / 255.f, ct))
-                );
+    gsi_camera(gsi, &bsf->scene.camera.cam, (uint32_t)fbs.x, (uint32_t)fbs.y);
+    for (uint32_t i = 0; i < it->count; ++i)
+    {
+        ecs_entity_t e = it->entities[i];
+        bsf_component_collider_t* cc = &cca[i];
+        bsf_component_transform_t* tc = &tca[i];
 
-                gs_vec3 s = gs_v3(-sx, 0.f, r);
-                gsi_rect3Dv(gsi, s, gs_v3(2 * sx, 0.f, r + step), gs_v2s(0.f), gs_v2s(1.f), color, GS_GRAPHICS_PRIMITIVE_TRIANGLES);
-            }
+        gsi_push_matrix(gsi, GSI_MATRIX_MODELVIEW);
+        {
+			gs_vqs xform = gs_vqs_absolute_transform(&cc->collider.xform, &tc->xform);
+            gsi_mul_matrix(gsi, gs_vqs_to_mat4(&xform));
+            switch (cc->collider.type)
+            {
+                default:
+                case BSF_COLLIDER_AABB:
+                {
+                    gs_aabb_t* s = &cc->collider.shape.aabb;
+                    gs_vec3 hd = gs_vec3_scale(gs_vec3_sub(s->max, s->min), 0.5f);
+                    gs_vec3 c = gs_vec3_add(s->min, hd);
+                    gsi_box(gsi, c.x, c.y, c.z, hd.x, hd.y, hd.z, 255, 255, 255, 255, GS_GRAPHICS_PRIMITIVE_LINES);
+                } break;
 
-            // Debug bounding area
-            gs_vec3 kb = {BSF_ROOM_BOUND_X, BSF_ROOM_BOUND_Y, BSF_ROOM_BOUND_Z}; 
-            /*
-            gsi_box(gsi, 0.f, kb.y / 2.f, 0.f, kb.x + 1.f, kb.y / 2.f, kb.z + 1.f, 0, 255, 0, 255, GS_GRAPHICS_PRIMITIVE_LINES);
-            */
+                case BSF_COLLIDER_SPHERE:
+                {
+                    gs_sphere_t* s = &cc->collider.shape.sphere;
+                    gsi_sphere(gsi, s->c.x, s->c.y, s->c.z, s->r, 255, 255, 255, 255, GS_GRAPHICS_PRIMITIVE_LINES); 
+                } break; 
 
-            // Drawing the tiny, moving guide boxes
-            for (float r = -sz; r <= step; r += step)
-            { 
-                for (float c = -sx; c < sx; c += step)
+                case BSF_COLLIDER_CYLINDER:
                 {
-                    // Draw columns
-                    float y = gs_perlin2(sx, sz);
-                    gsi_box(gsi, c, y * 0.5f, sz + zoff, 1.f, y * 0.5f, 1.f, 0, 255, 0, 255, GS_GRAPHICS_PRIMITIVE_TRIANGLES);
-                }
-            }
+                    gs_cylinder_t* s = &cc->collider.shape.cylinder;
+                    gsi_cylinder(gsi, s->base.x, s->base.y, s->base.z, s->r, s->r, s->height, 16, 255, 255, 255, 255, GS_GRAPHICS_PRIMITIVE_LINES); 
+                } break; 
 
-            // Do random boxes based on seed value (for obstacles) 
-            gs_mt_rand_t rand = gs_rand_seed(gs_hash_str64("mountains"));
-            for (uint32_t i = 0; i < 100; ++i) 
-            {
-                float rx = gs_rand_gen_range(&rand, -500, 500.f); 
-                float rsx = gs_rand_gen_range(&rand, 1.f, 50.f); 
-                float ry = gs_rand_gen_range(&rand, 1.f, kb.y); 
-                float rz = 1.f; 
-                gsi_box(gsi, rx, ry * 0.5f, -kb.z, rsx, ry * 0.5f, rz, 20, 100, 255, 255, GS_GRAPHICS_PRIMITIVE_TRIANGLES);
+                case BSF_COLLIDER_CONE:
+                { 
+                    gs_cone_t* s = &cc->collider.shape.cone;
+                    gsi_cone(gsi, s->base.x, s->base.y, s->base.z, s->r, s->height, 16, 255, 255, 255, 255, GS_GRAPHICS_PRIMITIVE_LINES);
+                } break;
             }
-
-        } break;
+        }
+        gsi_pop_matrix(gsi);
     }
+} 
+
+GS_API_DECL void bsf_renderable_immediate_system(ecs_iter_t* it)
+{
+    bsf_t* bsf = gs_user_data(bsf_t); 
+    bsf_component_renderable_immediate_t* rca = ecs_term(it, bsf_component_renderable_immediate_t, 1);
+    bsf_component_transform_t* tca = ecs_term(it, bsf_component_transform_t, 2);
+
+    // Collected here, batched by shape, material and texture in bsf_graphics_render
+    for (uint32_t i = 0; i < it->count; ++i)
+    { 
+		bsf_component_renderable_immediate_t* rc = &rca[i];
+		bsf_component_transform_t* tc = &tca[i];
 
+        if (rc->shape == BSF_SHAPE_ROOM) continue;
+                
+        rc->model = gs_vqs_to_mat4(&tc->xform); 
+        gs_gfxt_texture_t tex = rc->texture ? *rc->texture : GSI()->tex_default;
+        bsf_graphics_scene_immediate_push(&bsf->scene, rc->shape, rc->material, &rc->model, rc->color, tex);
+    }
 }
 
 GS_API_DECL void bsf_renderable_system(ecs_iter_t* it)
@@ -1873,7 +5973,7 @@ GS_API_DECL void bsf_camera_shake(struct bsf_t* bsf, bsf_camera_t* camera, float
 
 GS_API_DECL ecs_entity_t bsf_obstacle_create(struct bsf_t* bsf, gs_vqs* xform, bsf_obstacle_type type)
 {
-    gs_gfxt_material_t* mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.gsi"));
+    gs_gfxt_material_t* mat = bsf->assets.hndl.mat_gsi;
     ecs_entity_t e = ecs_new(bsf->entities.world, 0); 
 
     ecs_set(bsf->entities.world, e, bsf_component_transform_t, {.xform = *xform});
@@ -1890,7 +5990,7 @@ GS_API_DECL ecs_entity_t bsf_obstacle_create(struct bsf_t* bsf, gs_vqs* xform, b
                 .color = GS_COLOR_WHITE
             });
 
-	        ecs_set(bsf->entities.world, e, bsf_component_physics_t, {
+	        ecs_set(bsf->entities.world, e, bsf_component_collider_t, {
 				.collider = {
 					.type = BSF_COLLIDER_AABB,
 					.xform = gs_vqs_default(),
@@ -1902,6 +6002,8 @@ GS_API_DECL ecs_entity_t bsf_obstacle_create(struct bsf_t* bsf, gs_vqs* xform, b
             });
         } break;
     }
+
+    return e;
 } 
 
 GS_API_DECL void bsf_obstacle_system(ecs_iter_t* it)
@@ -1914,11 +6016,9 @@ GS_API_DECL void bsf_obstacle_system(ecs_iter_t* it)
     const float t = gs_platform_elapsed_time();
     const float dt = gs_platform_delta_time() * bsf->run.time_scale; 
     bsf_component_transform_t* tca = ecs_term(it, bsf_component_transform_t, 1);
-    bsf_component_physics_t* pca = ecs_term(it, bsf_component_physics_t, 2); 
-    bsf_component_obstacle_t* oca = ecs_term(it, bsf_component_obstacle_t, 3); 
+    bsf_component_obstacle_t* oca = ecs_term(it, bsf_component_obstacle_t, 2); 
 
     bsf_component_transform_t* ptc = ecs_get(bsf->entities.world, bsf->entities.player, bsf_component_transform_t);
-    bsf_component_physics_t* ppc = ecs_get(bsf->entities.world, bsf->entities.player, bsf_component_physics_t); 
 
     float speed_mod = gp->axes[GS_PLATFORM_JOYSTICK_AXIS_RTRIGGER] >= 0.4f || gs_platform_key_down(GS_KEYCODE_LEFT_SHIFT) ? 35.f : 20.f;
     if (room->cleared) speed_mod = 50.f;
@@ -1929,7 +6029,6 @@ GS_API_DECL void bsf_obstacle_system(ecs_iter_t* it)
     {
         ecs_entity_t ent = it->entities[i];
         bsf_component_transform_t* tc = &tca[i];
-        bsf_component_physics_t* pc = &pca[i]; 
         bsf_component_obstacle_t* oc = &oca[i]; 
 
         // Move obstacle forward over time towards player over time, snap back to start
@@ -1974,30 +6073,30 @@ GS_API_DECL void bsf_item_remove_from_pool(struct bsf_t* bsf, bsf_item_type type
 GS_API_DECL ecs_entity_t bsf_item_create(struct bsf_t* bsf, ecs_world_t* world, gs_vqs* xform, bsf_item_type type) 
 {
     // Use a simple texture material with the assigned texture
-    gs_gfxt_material_t* mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.gsi"));
+    gs_gfxt_material_t* mat = bsf->assets.hndl.mat_gsi;
     ecs_entity_t e = ecs_new(world, 0); 
     gs_gfxt_texture_t* tex = NULL;
 
     switch (type)
     {
         case BSF_ITEM_SAD_ONION: {
-            tex = gs_hash_table_getp(bsf->assets.textures, gs_hash_str64("tex.icon_sad_onion"));
+            tex = bsf->assets.hndl.tex_icon_sad_onion;
         } break;
 
         case BSF_ITEM_INNER_EYE: {
-            tex = gs_hash_table_getp(bsf->assets.textures, gs_hash_str64("tex.icon_inner_eye"));
+            tex = bsf->assets.hndl.tex_icon_inner_eye;
         } break;
 
         case BSF_ITEM_SPOON_BENDER: {
-            tex = gs_hash_table_getp(bsf->assets.textures, gs_hash_str64("tex.icon_spoon_bender"));
+            tex = bsf->assets.hndl.tex_icon_spoon_bender;
         } break;
 
         case BSF_ITEM_MAGIC_MUSHROOM: {
-            tex = gs_hash_table_getp(bsf->assets.textures, gs_hash_str64("tex.icon_magic_mushroom"));
+            tex = bsf->assets.hndl.tex_icon_magic_mushroom;
         } break;
 
         case BSF_ITEM_POLYPHEMUS: { 
-            tex = gs_hash_table_getp(bsf->assets.textures, gs_hash_str64("tex.icon_polyphemus"));
+            tex = bsf->assets.hndl.tex_icon_polyphemus;
         } break;
     }
 
@@ -2013,7 +6112,7 @@ GS_API_DECL ecs_entity_t bsf_item_create(struct bsf_t* bsf, ecs_world_t* world,
 		.texture = tex
     });
 
-    ecs_set(world, e, bsf_component_physics_t, {
+    ecs_set(world, e, bsf_component_collider_t, {
         .collider = {
             .type = BSF_COLLIDER_AABB,
 			.xform = (gs_vqs) {
@@ -2106,11 +6205,9 @@ GS_API_DECL void bsf_item_system(ecs_iter_t* it)
     const gs_platform_input_t* input = gs_platform_input();
     const gs_platform_gamepad_t* gp = &input->gamepads[0];
     bsf_component_transform_t* tca = ecs_term(it, bsf_component_transform_t, 1);
-    bsf_component_physics_t* pca = ecs_term(it, bsf_component_physics_t, 2); 
-    bsf_component_item_t* ica = ecs_term(it, bsf_component_item_t, 3); 
-    bsf_component_ai_t* aica = ecs_term(it, bsf_component_ai_t, 4); 
+    bsf_component_item_t* ica = ecs_term(it, bsf_component_item_t, 2); 
+    bsf_component_ai_t* aica = ecs_term(it, bsf_component_ai_t, 3); 
     bsf_component_transform_t* ptc = ecs_get(bsf->entities.world, bsf->entities.player, bsf_component_transform_t);
-    bsf_component_physics_t* ppc = ecs_get(bsf->entities.world, bsf->entities.player, bsf_component_physics_t); 
 
     if (bsf->dbg) return; 
 
@@ -2118,13 +6215,11 @@ GS_API_DECL void bsf_item_system(ecs_iter_t* it)
     {
         ecs_entity_t ent = it->entities[i];
         bsf_component_transform_t* tc = &tca[i];
-        bsf_component_physics_t* pc = &pca[i]; 
         bsf_component_item_t* ic = &ica[i];
 		bsf_component_ai_t* ai = &aica[i];
 		
 		bsf_ai_data_t data = {
 			.tc = tc,
-			.pc = pc,
 			.ac = ai,
 			.ptc = ptc,
 			.ent = ent,
@@ -2162,7 +6257,7 @@ GS_API_DECL void bsf_item_destroy(ecs_world_t* world, ecs_entity_t ent)
 
 GS_API_DECL ecs_entity_t bsf_item_chest_create(struct bsf_t* bsf, gs_vqs* xform, bsf_item_type type)
 {
-    gs_gfxt_material_t* mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.gsi"));
+    gs_gfxt_material_t* mat = bsf->assets.hndl.mat_gsi;
     ecs_entity_t e = ecs_new(bsf->entities.world, 0); 
 
     ecs_set(bsf->entities.world, e, bsf_component_renderable_immediate_t, {
@@ -2172,7 +6267,7 @@ GS_API_DECL ecs_entity_t bsf_item_chest_create(struct bsf_t* bsf, gs_vqs* xform,
         .color = GS_COLOR_ORANGE
     });
 
-    ecs_set(bsf->entities.world, e, bsf_component_physics_t, {
+    ecs_set(bsf->entities.world, e, bsf_component_collider_t, {
         .collider = {
             .type = BSF_COLLIDER_AABB,
             .xform = gs_vqs_default(),
@@ -2212,11 +6307,9 @@ GS_API_DECL void bsf_item_chest_system(ecs_iter_t* it)
     const gs_platform_input_t* input = gs_platform_input();
     const gs_platform_gamepad_t* gp = &input->gamepads[0];
     bsf_component_transform_t* tca = ecs_term(it, bsf_component_transform_t, 1);
-    bsf_component_physics_t* pca = ecs_term(it, bsf_component_physics_t, 2); 
-    bsf_component_item_chest_t* ica = ecs_term(it, bsf_component_item_chest_t, 3); 
-	bsf_component_renderable_immediate_t* rca = ecs_term(it, bsf_component_renderable_immediate_t, 4);
+    bsf_component_item_chest_t* ica = ecs_term(it, bsf_component_item_chest_t, 2); 
+	bsf_component_renderable_immediate_t* rca = ecs_term(it, bsf_component_renderable_immediate_t, 3);
     bsf_component_transform_t* ptc = ecs_get(bsf->entities.world, bsf->entities.player, bsf_component_transform_t);
-    bsf_component_physics_t* ppc = ecs_get(bsf->entities.world, bsf->entities.player, bsf_component_physics_t); 
 
     if (bsf->dbg) return; 
 
@@ -2224,7 +6317,6 @@ GS_API_DECL void bsf_item_chest_system(ecs_iter_t* it)
     {
         ecs_entity_t ent = it->entities[i];
         bsf_component_transform_t* tc = &tca[i];
-        bsf_component_physics_t* pc = &pca[i]; 
         bsf_component_item_chest_t* ic = &ica[i];
 		bsf_component_renderable_immediate_t* rc = &rca[i];
 
@@ -2252,6 +6344,7 @@ GS_API_DECL void bsf_item_chest_system(ecs_iter_t* it)
 				bsf_explosion_create(bsf, it->world, &tc->xform, BSF_OWNER_PLAYER); 
                 ecs_entity_t e = bsf_item_create(bsf, it->world, &tc->xform, ic->type);
 				gs_dyn_array_push(room->items, e);
+				bsf_room_add_entity(bsf, room, e);
 				bsf_item_chest_destroy(it->world, ent);
 			}
 		} 
@@ -2313,7 +6406,7 @@ GS_API_DECL void bsf_consumable_destroy(ecs_world_t* world, ecs_entity_t ent)
 
 GS_API_DECL ecs_entity_t bsf_consumable_create(struct bsf_t* bsf, gs_vqs* xform, bsf_consumable_type type)
 {
-    gs_gfxt_material_t* mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.gsi"));
+    gs_gfxt_material_t* mat = bsf->assets.hndl.mat_gsi;
     ecs_entity_t e = ecs_new(bsf->entities.world, 0); 
 
     switch (type)
@@ -2327,7 +6420,7 @@ GS_API_DECL ecs_entity_t bsf_consumable_create(struct bsf_t* bsf, gs_vqs* xform,
                 .color = GS_COLOR_RED
             });
 
-	        ecs_set(bsf->entities.world, e, bsf_component_physics_t, {
+	        ecs_set(bsf->entities.world, e, bsf_component_collider_t, {
 				.collider = {
 					.type = BSF_COLLIDER_AABB,
 					.xform = gs_vqs_default(),
@@ -2349,7 +6442,7 @@ GS_API_DECL ecs_entity_t bsf_consumable_create(struct bsf_t* bsf, gs_vqs* xform,
                 .color = gs_color(10, 140, 225, 255)
             });
 
-	        ecs_set(bsf->entities.world, e, bsf_component_physics_t, {
+	        ecs_set(bsf->entities.world, e, bsf_component_collider_t, {
 				.collider = {
 					.type = BSF_COLLIDER_SPHERE,
 					.xform = gs_vqs_default(),
@@ -2390,10 +6483,10 @@ GS_API_DECL void bsf_consumable_system(ecs_iter_t* it)
     const gs_platform_input_t* input = gs_platform_input();
     const gs_platform_gamepad_t* gp = &input->gamepads[0];
     bsf_component_transform_t* tca = ecs_term(it, bsf_component_transform_t, 1);
-    bsf_component_physics_t* pca = ecs_term(it, bsf_component_physics_t, 2); 
+    bsf_component_collider_t* cca = ecs_term(it, bsf_component_collider_t, 2); 
     bsf_component_consumable_t* ica = ecs_term(it, bsf_component_consumable_t, 3);
     bsf_component_transform_t* ptc = ecs_get(bsf->entities.world, bsf->entities.player, bsf_component_transform_t);
-    bsf_component_physics_t* ppc = ecs_get(bsf->entities.world, bsf->entities.player, bsf_component_physics_t);
+    bsf_component_collider_t* pcc = ecs_get(bsf->entities.world, bsf->entities.player, bsf_component_collider_t);
 
     float speed_mod = gp->axes[GS_PLATFORM_JOYSTICK_AXIS_RTRIGGER] >= 0.4f || gs_platform_key_down(GS_KEYCODE_LEFT_SHIFT) ? 35.f : 20.f;
     if (room->cleared) speed_mod = 35.f;
@@ -2404,7 +6497,7 @@ GS_API_DECL void bsf_consumable_system(ecs_iter_t* it)
     {
         ecs_entity_t ent = it->entities[i];
         bsf_component_transform_t* tc = &tca[i];
-        bsf_component_physics_t* pc = &pca[i]; 
+        bsf_component_collider_t* cc = &cca[i]; 
         bsf_component_consumable_t* ic = &ica[i]; 
 
         gs_vqs offset = (gs_vqs){
@@ -2433,7 +6526,8 @@ GS_API_DECL void bsf_consumable_system(ecs_iter_t* it)
         }; 
 
         // Check for collision against player
-        gs_contact_info_t res = bsf_component_physics_collide(pc, &tc->xform, ppc, &ptc->xform); 
+        bsf_component_collider_bake(cc, &tc->xform);
+        gs_contact_info_t res = bsf_component_physics_collide(cc, &tc->xform, pcc, &ptc->xform); 
 
         if (res.hit)
         {
@@ -2456,11 +6550,11 @@ GS_API_DECL ecs_entity_t bsf_mob_create(struct bsf_t* bsf, ecs_world_t* world, g
     {
         case BSF_MOB_BOSS:
         {
-            gs_gfxt_material_t* mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.brain"));
-            gs_gfxt_mesh_t* mesh = gs_hash_table_getp(bsf->assets.meshes, gs_hash_str64("mesh.brain")); 
-            gs_gfxt_texture_t* tex = gs_hash_table_getp(bsf->assets.textures, gs_hash_str64("tex.default"));
-            gs_gfxt_material_set_uniform(mat, "u_color", &(gs_vec3){1.f, 1.f, 1.f}); 
-            gs_gfxt_material_set_uniform(mat, "u_tex", tex); 
+            gs_gfxt_material_t* mat = bsf->assets.hndl.mat_brain;
+            gs_gfxt_mesh_t* mesh = bsf->assets.hndl.mesh_brain; 
+            gs_gfxt_texture_t* tex = bsf->assets.hndl.tex_default;
+            BSF_MATERIAL_SET_UNIFORM(&bsf->assets, mat, u_color, &(gs_vec3){1.f, 1.f, 1.f}); 
+            BSF_MATERIAL_SET_UNIFORM(&bsf->assets, mat, u_tex, tex); 
 
             xform->scale = gs_v3s(1.f); 
             ecs_set(world, e, bsf_component_transform_t, {.xform = *xform});
@@ -2473,7 +6567,7 @@ GS_API_DECL ecs_entity_t bsf_mob_create(struct bsf_t* bsf, ecs_world_t* world, g
                 })
             }); 
 
-	        ecs_set(world, e, bsf_component_physics_t, {
+	        ecs_set(world, e, bsf_component_collider_t, {
 				.collider = {
 					.type = BSF_COLLIDER_AABB,
 					.xform = (gs_vqs){
@@ -2498,11 +6592,11 @@ GS_API_DECL ecs_entity_t bsf_mob_create(struct bsf_t* bsf, ecs_world_t* world, g
 
         case BSF_MOB_TURRET:
         {
-            gs_gfxt_material_t* mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.turret"));
-            gs_gfxt_mesh_t* mesh = gs_hash_table_getp(bsf->assets.meshes, gs_hash_str64("mesh.turret")); 
-            gs_gfxt_texture_t* tex = gs_hash_table_getp(bsf->assets.textures, gs_hash_str64("tex.arwing"));
-            gs_gfxt_material_set_uniform(mat, "u_color", &(gs_vec3){0.5f, 0.8f, 0.2f}); 
-            gs_gfxt_material_set_uniform(mat, "u_tex", tex); 
+            gs_gfxt_material_t* mat = bsf->assets.hndl.mat_turret;
+            gs_gfxt_mesh_t* mesh = bsf->assets.hndl.mesh_turret; 
+            gs_gfxt_texture_t* tex = bsf->assets.hndl.tex_arwing;
+            BSF_MATERIAL_SET_UNIFORM(&bsf->assets, mat, u_color, &(gs_vec3){0.5f, 0.8f, 0.2f}); 
+            BSF_MATERIAL_SET_UNIFORM(&bsf->assets, mat, u_tex, tex); 
 
             xform->scale = gs_v3s(0.1f);
             ecs_set(world, e, bsf_component_transform_t, {.xform = *xform});
@@ -2515,7 +6609,7 @@ GS_API_DECL ecs_entity_t bsf_mob_create(struct bsf_t* bsf, ecs_world_t* world, g
                 })
             }); 
 
-	        ecs_set(world, e, bsf_component_physics_t, {
+	        ecs_set(world, e, bsf_component_collider_t, {
 				.collider = {
 					.type = BSF_COLLIDER_AABB,
 					.xform = (gs_vqs){
@@ -2540,11 +6634,11 @@ GS_API_DECL ecs_entity_t bsf_mob_create(struct bsf_t* bsf, ecs_world_t* world, g
 
         case BSF_MOB_BANDIT: 
         { 
-            gs_gfxt_material_t* mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.bandit"));
-            gs_gfxt_mesh_t* mesh = gs_hash_table_getp(bsf->assets.meshes, gs_hash_str64("mesh.bandit")); 
-            gs_gfxt_texture_t* tex = gs_hash_table_getp(bsf->assets.textures, gs_hash_str64("tex.arwing"));
-            gs_gfxt_material_set_uniform(mat, "u_color", &(gs_vec3){1.f, 0.4f, 0.1f}); 
-            gs_gfxt_material_set_uniform(mat, "u_tex", tex); 
+            gs_gfxt_material_t* mat = bsf->assets.hndl.mat_bandit;
+            gs_gfxt_mesh_t* mesh = bsf->assets.hndl.mesh_bandit; 
+            gs_gfxt_texture_t* tex = bsf->assets.hndl.tex_arwing;
+            BSF_MATERIAL_SET_UNIFORM(&bsf->assets, mat, u_color, &(gs_vec3){1.f, 0.4f, 0.1f}); 
+            BSF_MATERIAL_SET_UNIFORM(&bsf->assets, mat, u_tex, tex); 
 
             xform->scale = gs_v3s(0.3f);
             xform->rotation = gs_quat_angle_axis(gs_deg2rad(180.f), GS_YAXIS);
@@ -2558,7 +6652,7 @@ GS_API_DECL ecs_entity_t bsf_mob_create(struct bsf_t* bsf, ecs_world_t* world, g
                 })
             }); 
 
-	        ecs_set(world, e, bsf_component_physics_t, {
+	        ecs_set(world, e, bsf_component_collider_t, {
 				.collider = {
 					.type = BSF_COLLIDER_AABB,
 					.xform = (gs_vqs){
@@ -2584,6 +6678,7 @@ GS_API_DECL ecs_entity_t bsf_mob_create(struct bsf_t* bsf, ecs_world_t* world, g
  
     ecs_set(world, e, bsf_component_mob_t, {.type = type});
     ecs_set(world, e, bsf_component_gun_t, {0}); 
+    ecs_set(world, e, bsf_component_velocity_t, {0});
 
     return e;
 } 
@@ -2750,7 +6845,8 @@ void bsf_ai_task_spawn_bandit(struct gs_ai_bt_t* bt, struct gs_ai_bt_node_t* nod
     gs_vqs xform = gs_vqs_default();
     xform.translation = gs_vec3_add(data->tc->xform.translation, gs_vec3_scale(dir, rad));
     ecs_entity_t e = bsf_mob_create(bsf, data->world, &xform, type);
-    gs_dyn_array_push(room->mobs, e); 
+    gs_dyn_array_push(room->mobs, e);
+    bsf_room_add_entity(bsf, room, e); 
 
     node->state = GS_AI_BT_STATE_SUCCESS;
 }
@@ -2803,7 +6899,7 @@ void bsf_ai_task_shoot_at_player(struct gs_ai_bt_t* bt, struct gs_ai_bt_node_t*
                 };
 
                 // Play sound 
-                bsf_play_sound(bsf, "audio.laser2", 0.1f);
+                bsf_play_sound(bsf, bsf->assets.hndl.audio_laser2, 0.1f);
 
                 float speed = 5.f; 
                 bsf_projectile_create(bsf, data->world, BSF_PROJECTILE_BULLET, BSF_OWNER_ENEMY, &xform, gs_vec3_scale(forward, speed));
@@ -2822,7 +6918,7 @@ void bsf_ai_task_shoot_at_player(struct gs_ai_bt_t* bt, struct gs_ai_bt_node_t*
                 bsf_projectile_create(bsf, data->world, BSF_PROJECTILE_BULLET, BSF_OWNER_ENEMY, &xform, gs_vec3_scale(forward, speed));
 
                 // Play sound 
-                bsf_play_sound(bsf, "audio.laser2", 0.1f);
+                bsf_play_sound(bsf, bsf->assets.hndl.audio_laser2, 0.1f);
 
                 if (gs_rand_gen_long(&bsf->run.rand) % 2) node->state = GS_AI_BT_STATE_SUCCESS;
             } break;
@@ -2839,7 +6935,7 @@ void bsf_ai_task_shoot_at_player(struct gs_ai_bt_t* bt, struct gs_ai_bt_node_t*
                 bsf_projectile_create(bsf, data->world, BSF_PROJECTILE_BULLET, BSF_OWNER_ENEMY, &xform, gs_vec3_scale(forward, speed));
 
                 // Play sound 
-                bsf_play_sound(bsf, "audio.laser2", 0.1f);
+                bsf_play_sound(bsf, bsf->assets.hndl.audio_laser2, 0.1f);
 
                 if (gs_rand_gen_long(&bsf->run.rand) % 33 == 0) node->state = GS_AI_BT_STATE_SUCCESS;
             } break;
@@ -2873,8 +6969,8 @@ void bsf_ai_task_random_impulse(struct gs_ai_bt_t* bt, struct gs_ai_bt_node_t* n
         gs_rand_gen_range(&bsf->run.rand, -1.f, 1.f), 
         gs_rand_gen_range(&bsf->run.rand, -1.f, 1.f)
     );
-    data->pc->velocity = gs_vec3_scale(gs_vec3_norm(impulse), gs_rand_gen_range(&bsf->run.rand, 0.1f, 0.3f));
-    data->pc->angular_velocity = gs_vec3_scale(gs_vec3_norm(angular_impulse), 10.f);
+    data->vc->velocity = gs_vec3_scale(gs_vec3_norm(impulse), gs_rand_gen_range(&bsf->run.rand, 0.1f, 0.3f));
+    data->vc->angular_velocity = gs_vec3_scale(gs_vec3_norm(angular_impulse), 10.f);
     node->state = GS_AI_BT_STATE_SUCCESS;
 }
 
@@ -2888,8 +6984,8 @@ void bsf_ai_task_fall_to_death(struct gs_ai_bt_t* bt, struct gs_ai_bt_node_t* no
     // Continue to fall until y = 0.f, then diE!
     gs_quat* rot = &data->tc->xform.rotation;
     gs_vec3* pos = &data->tc->xform.translation;
-    gs_vec3* vel = &data->pc->velocity;
-    gs_vec3* av = &data->pc->angular_velocity;
+    gs_vec3* vel = &data->vc->velocity;
+    gs_vec3* av = &data->vc->angular_velocity;
 
     if (pos->y >= 0.f)
     { 
@@ -2922,7 +7018,8 @@ void bsf_ai_task_fall_to_death(struct gs_ai_bt_t* bt, struct gs_ai_bt_node_t* no
                 gs_vqs xform = data->tc->xform;
                 xform.scale = gs_v3s(50.f);
                 bsf_explosion_create(bsf, data->world, &xform, BSF_OWNER_PLAYER);
-                bsf_play_sound(bsf, "audio.explosion_boss", 0.5f);
+                bsf_particles_emit(&bsf->particles, BSF_PARTICLE_BOSS_DEATH, xform.translation, 1.f);
+                bsf_play_sound(bsf, bsf->assets.hndl.audio_explosion_boss, 0.5f);
             } break; 
         }
         bsf_mob_destroy(data->world, data->ent); 
@@ -3070,11 +7167,12 @@ GS_API_DECL void bsf_mob_system(ecs_iter_t* it)
     const float dt = gs_platform_delta_time() * bsf->run.time_scale; 
     bsf_component_renderable_t* rca = ecs_term(it, bsf_component_renderable_t, 1);
     bsf_component_transform_t* tca = ecs_term(it, bsf_component_transform_t, 2);
-    bsf_component_physics_t* pca = ecs_term(it, bsf_component_physics_t, 3); 
+    bsf_component_velocity_t* vca = ecs_term(it, bsf_component_velocity_t, 3); 
     bsf_component_health_t* hca = ecs_term(it, bsf_component_health_t, 4);
     bsf_component_mob_t* mca = ecs_term(it, bsf_component_mob_t, 5);
     bsf_component_gun_t* bca = ecs_term(it, bsf_component_gun_t, 6); 
     bsf_component_ai_t* aic = ecs_term(it, bsf_component_ai_t, 7);
+    bsf_component_collider_t* cca = ecs_term(it, bsf_component_collider_t, 8);
     bsf_component_transform_t* ptc = ecs_get(bsf->entities.world, bsf->entities.player, bsf_component_transform_t);
 
     if (bsf->dbg) return; 
@@ -3084,7 +7182,8 @@ GS_API_DECL void bsf_mob_system(ecs_iter_t* it)
         ecs_entity_t ent = it->entities[i];
         bsf_component_renderable_t* rc = &rca[i];
         bsf_component_transform_t* tc = &tca[i];
-        bsf_component_physics_t* pc = &pca[i]; 
+        bsf_component_velocity_t* vc = &vca[i]; 
+        bsf_component_collider_t* cc = &cca[i];
         bsf_component_health_t* hc = &hca[i];
         bsf_component_mob_t* mc = &mca[i];
         bsf_component_gun_t* gc = &bca[i];
@@ -3094,7 +7193,7 @@ GS_API_DECL void bsf_mob_system(ecs_iter_t* it)
         bsf_ai_data_t ai_data = (bsf_ai_data_t){
             .gc = gc,
             .tc = tc,
-            .pc = pc,
+            .vc = vc,
             .hc = hc,
             .mc = mc,
             .ptc = ptc, 
@@ -3147,23 +7246,18 @@ GS_API_DECL void bsf_mob_system(ecs_iter_t* it)
             } break;
         }
 
+        // Mobs are tested against after moving this frame (explosions), so refresh bounds
+        bsf_component_collider_bake(cc, &tc->xform);
+
         // Do collision hit
         if (hc->hit)
         {
-            gs_gfxt_material_t* hit_mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.hit"));
-            gs_gfxt_material_set_uniform(hit_mat, "u_color", &(gs_vec3){1.f, 1.f, 1.f}); 
+            // Flash white, material (and batch) stays the same
             bsf_renderable_t* rend = gs_slot_array_getp(bsf->scene.renderables, rc->hndl);
-            rend->material = hit_mat;
-            gs_gfxt_material_t* mat = NULL;
+            rend->flash = gs_v4s(1.f);
 
             if (hc->hit_timer >= 0.1f) {
-                switch (mc->type)
-                {
-                    case BSF_MOB_BANDIT: mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.bandit")); break;
-                    case BSF_MOB_TURRET: mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.turret")); break;
-                    case BSF_MOB_BOSS:   mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.brain")); break;
-                }
-                rend->material = mat;
+                rend->flash.w = 0.f;
                 hc->hit = false;
 				hc->hit_timer = 0.f;
             } 
@@ -3177,22 +7271,14 @@ GS_API_DECL void bsf_mob_system(ecs_iter_t* it)
 
 GS_API_DECL void bsf_projectile_create(struct bsf_t* bsf, ecs_world_t* world, bsf_projectile_type type, bsf_owner_type owner, const gs_vqs* xform, gs_vec3 velocity)
 {
-	gs_gfxt_material_t* mat = NULL; 
-    gs_gfxt_mesh_t* mesh = gs_hash_table_getp(bsf->assets.meshes, gs_hash_str64("mesh.laser_player"));
+	gs_gfxt_material_t* mat = bsf->assets.hndl.mat_laser; 
+    gs_gfxt_mesh_t* mesh = bsf->assets.hndl.mesh_laser_player;
+    gs_vec4 tint = gs_v4s(1.f);
 
 	switch ( owner )
 	{
-		case BSF_OWNER_PLAYER:
-		{ 
-			mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.laser_player"));
-			gs_gfxt_material_set_uniform(mat, "u_color", &(gs_vec3){0.f, 1.f, 0.f}); 
-		} break;
-
-		case BSF_OWNER_ENEMY:
-		{
-			mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.laser_enemy"));
-			gs_gfxt_material_set_uniform(mat, "u_color", &(gs_vec3){1.f, 0.f, 0.f}); 
-		} break;
+		case BSF_OWNER_PLAYER: tint = gs_v4(0.f, 1.f, 0.f, 1.f); break;
+		case BSF_OWNER_ENEMY:  tint = gs_v4(1.f, 0.f, 0.f, 1.f); break;
 	}
 
     const float speed = gs_vec3_len(velocity);
@@ -3209,13 +7295,17 @@ GS_API_DECL void bsf_projectile_create(struct bsf_t* bsf, ecs_world_t* world, bs
                 .hndl = bsf_graphics_scene_renderable_create(&bsf->scene, &(bsf_renderable_desc_t){
                     .material = mat,
                     .mesh = mesh,
-                    .model = gs_vqs_to_mat4(xform)
+                    .model = gs_vqs_to_mat4(xform),
+                    .tint = tint
                 })
             });
 
-            ecs_set(world, b, bsf_component_physics_t, {
+            ecs_set(world, b, bsf_component_velocity_t, {
                 .velocity = velocity, 
-                .speed = speed,
+                .speed = speed
+            });
+
+            ecs_set(world, b, bsf_component_collider_t, {
                 .collider = {
                     .xform = (gs_vqs) { 
                         .translation = gs_v3(0.f, 0.f, 0.4f),
@@ -3237,9 +7327,12 @@ GS_API_DECL void bsf_projectile_create(struct bsf_t* bsf, ecs_world_t* world, bs
 
         case BSF_PROJECTILE_BOMB:
         {
-            ecs_set(world, b, bsf_component_physics_t, {
+            ecs_set(world, b, bsf_component_velocity_t, {
                 .velocity = velocity, 
-                .speed = speed,
+                .speed = speed
+            });
+
+            ecs_set(world, b, bsf_component_collider_t, {
                 .collider = {
                     .xform = gs_vqs_default(),
                     .type = BSF_COLLIDER_SPHERE,
@@ -3267,7 +7360,7 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it)
     const gs_vec2 fbs = gs_platform_framebuffer_sizev(gs_platform_main_window());
     bsf_component_renderable_t* rca = ecs_term(it, bsf_component_renderable_t, 1);
     bsf_component_transform_t* tca = ecs_term(it, bsf_component_transform_t, 2);
-    bsf_component_physics_t* pca = ecs_term(it, bsf_component_physics_t, 3); 
+    bsf_component_velocity_t* vca = ecs_term(it, bsf_component_velocity_t, 3); 
     bsf_component_timer_t* kca = ecs_term(it, bsf_component_timer_t, 4);
     bsf_component_projectile_t* bca = ecs_term(it, bsf_component_projectile_t, 5);
     bsf_room_t* room = gs_slot_array_getp(bsf->run.rooms, bsf->run.room_ids[bsf->run.cell]); 
@@ -3278,7 +7371,7 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it)
     {
 		bsf_component_renderable_t* rc = &rca[i];
 		bsf_component_transform_t* tc = &tca[i];
-		bsf_component_physics_t* pc = &pca[i];
+		bsf_component_velocity_t* vc = &vca[i];
 		bsf_component_timer_t* kc = &kca[i];
 		bsf_component_projectile_t* bc = &bca[i];
 
@@ -3294,7 +7387,7 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it)
                 )
                 {
                     float dist = FLT_MAX;
-                    gs_vec3 vel = pc->velocity;
+                    gs_vec3 vel = vc->velocity;
                     for (uint32_t m = 0; m < gs_dyn_array_size(room->mobs); ++m)
                     {
                         bsf_component_transform_t* mtc = ecs_get(it->world, room->mobs[m], bsf_component_transform_t);
@@ -3306,12 +7399,12 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it)
                         }
                     }
                     
-                    pc->velocity = gs_vec3_norm(vel);
+                    vc->velocity = gs_vec3_norm(vel);
 
                     gsi_defaults(&bsf->gs.gsi);
                     gsi_depth_enabled(&bsf->gs.gsi, true);
                     gsi_camera(&bsf->gs.gsi, &bsf->scene.camera.cam, (u32)fbs.x, (u32)fbs.y);
-                    gsi_line3Dv(&bsf->gs.gsi, tc->xform.translation, gs_vec3_add(tc->xform.translation, gs_vec3_scale(pc->velocity, 5.f)), GS_COLOR_BLUE);
+                    gsi_line3Dv(&bsf->gs.gsi, tc->xform.translation, gs_vec3_add(tc->xform.translation, gs_vec3_scale(vc->velocity, 5.f)), GS_COLOR_BLUE);
                 } 
 
             } break;
@@ -3320,8 +7413,8 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it)
         ecs_entity_t projectile = it->entities[i];
 		gs_vqs* xform = &tc->xform;
         gs_vec3* trans = &xform->position; 
-        const gs_vec3* vel = &pc->velocity; 
-        const float speed = pc->speed * dt;
+        const gs_vec3* vel = &vc->velocity; 
+        const float speed = vc->speed * dt;
 
         // Update position based on velocity and dt
         *trans = gs_vec3_add(*trans, gs_vec3_scale(*vel, speed)); 
@@ -3335,7 +7428,7 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it)
                 case BSF_PROJECTILE_BULLET:
                 {
                     ecs_delete(it->world, projectile);
-                    bsf_play_sound(bsf, "audio.hit_no_damage", 0.1f);
+                    bsf_play_sound(bsf, bsf->assets.hndl.audio_hit_no_damage, 0.1f);
                 } break;
 
                 case BSF_PROJECTILE_BOMB:
@@ -3349,6 +7442,35 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it)
             }
         } 
 
+        // Bombs have no mesh, trail is all that's drawn of them
+        if (bc->type == BSF_PROJECTILE_BOMB) {
+            bsf_particles_emit(&bsf->particles, BSF_PARTICLE_TRAIL, tc->xform.translation, 1.f);
+        }
+    } 
+} 
+
+GS_API_DECL void bsf_projectile_hit_system(ecs_iter_t* it)
+{
+    bsf_t* bsf = gs_user_data(bsf_t); 
+    bsf_component_transform_t* tca = ecs_term(it, bsf_component_transform_t, 1);
+    bsf_component_velocity_t* vca = ecs_term(it, bsf_component_velocity_t, 2); 
+    bsf_component_projectile_t* bca = ecs_term(it, bsf_component_projectile_t, 3);
+    bsf_component_collider_t* cca = ecs_term(it, bsf_component_collider_t, 4);
+    bsf_room_t* room = gs_slot_array_getp(bsf->run.rooms, bsf->run.room_ids[bsf->run.cell]); 
+
+    if (bsf->dbg) return;
+
+    for (uint32_t i = 0; i < it->count; ++i)
+    {
+		bsf_component_transform_t* tc = &tca[i];
+		bsf_component_velocity_t* vc = &vca[i];
+		bsf_component_collider_t* cc = &cca[i];
+		bsf_component_projectile_t* bc = &bca[i];
+        ecs_entity_t projectile = it->entities[i];
+
+        // Rotation only changes on reflection, so this is mostly a translate
+        bsf_component_collider_bake(cc, &tc->xform);
+
 		switch (bc->type)
 		{
 			case BSF_PROJECTILE_BULLET:
@@ -3361,9 +7483,9 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it)
 						{
 							ecs_entity_t mob = room->mobs[m]; 
 							bsf_component_transform_t* tform = ecs_get(bsf->entities.world, mob, bsf_component_transform_t);
-							bsf_component_physics_t* phys = ecs_get(bsf->entities.world, mob, bsf_component_physics_t); 
+							bsf_component_collider_t* col = ecs_get(bsf->entities.world, mob, bsf_component_collider_t); 
 
-							gs_contact_info_t res = bsf_component_physics_collide(pc, &tc->xform, phys, 
+							gs_contact_info_t res = bsf_component_physics_collide(cc, &tc->xform, col, 
 									&tform->xform); 
 
 							if (res.hit)
@@ -3373,7 +7495,8 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it)
 								h->health -= 1.f;
 								h->hit_timer = 0.f;
                                 bsf_camera_shake(bsf, &bsf->scene.camera, 0.1f);
-                                bsf_play_sound(bsf, "audio.bang", gs_rand_gen_range(&bsf->run.rand, 0.01f, 0.03f));
+                                bsf_particles_emit(&bsf->particles, BSF_PARTICLE_IMPACT, tc->xform.translation, 1.f);
+                                bsf_play_sound(bsf, bsf->assets.hndl.audio_bang, gs_rand_gen_range(&bsf->run.rand, 0.01f, 0.03f));
 								ecs_delete(it->world, projectile);
 								break;
 							} 
@@ -3384,8 +7507,8 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it)
 						{ 
 							ecs_entity_t item = room->items[ie];
 							bsf_component_transform_t* tform = ecs_get(bsf->entities.world, item, bsf_component_transform_t);
-							bsf_component_physics_t* phys = ecs_get(bsf->entities.world, item, bsf_component_physics_t); 
-							gs_contact_info_t res = bsf_component_physics_collide(pc, &tc->xform, phys, &tform->xform);
+							bsf_component_collider_t* col = ecs_get(bsf->entities.world, item, bsf_component_collider_t); 
+							gs_contact_info_t res = bsf_component_physics_collide(cc, &tc->xform, col, &tform->xform);
 
 							if (res.hit)
 							{ 
@@ -3395,7 +7518,8 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it)
 									cp->hit = true;
 									cp->hit_timer = 0.f;
 									bsf_camera_shake(bsf, &bsf->scene.camera, 0.1f);
-									bsf_play_sound(bsf, "audio.bang", gs_rand_gen_range(&bsf->run.rand, 0.01f, 0.03f));
+                                    bsf_particles_emit(&bsf->particles, BSF_PARTICLE_IMPACT, tc->xform.translation, 1.f);
+									bsf_play_sound(bsf, bsf->assets.hndl.audio_bang, gs_rand_gen_range(&bsf->run.rand, 0.01f, 0.03f));
 									ecs_delete(it->world, projectile);
 									break; 
 								}
@@ -3408,9 +7532,9 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it)
 					{
 						// Check collision against player
 						bsf_component_transform_t* ptc = ecs_get(bsf->entities.world, bsf->entities.player, bsf_component_transform_t);
-						bsf_component_physics_t* ppc = ecs_get(bsf->entities.world, bsf->entities.player, bsf_component_physics_t); 
+						bsf_component_collider_t* pcc = ecs_get(bsf->entities.world, bsf->entities.player, bsf_component_collider_t); 
                         bsf_component_barrel_roll_t* pbc = ecs_get(bsf->entities.world, bsf->entities.player, bsf_component_barrel_roll_t);
-						gs_contact_info_t res = bsf_component_physics_collide(pc, &tc->xform, ppc, &ptc->xform); 
+						gs_contact_info_t res = bsf_component_physics_collide(cc, &tc->xform, pcc, &ptc->xform); 
 
 						if (res.hit)
 						{ 
@@ -3423,22 +7547,23 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it)
                                     gs_rand_gen(&bsf->run.rand),
                                     gs_rand_gen(&bsf->run.rand)
                                 ));
-                                gs_vec3 dir = gs_vec3_norm(gs_vec3_add(gs_vec3_scale(gs_vec3_norm(pc->velocity), -1.f), gs_vec3_scale(off, 0.1f)));
+                                gs_vec3 dir = gs_vec3_norm(gs_vec3_add(gs_vec3_scale(gs_vec3_norm(vc->velocity), -1.f), gs_vec3_scale(off, 0.1f)));
 
                                 // Change the orientation to match new velocity
-                                gs_vec3 forward = gs_vec3_norm(pc->velocity);
+                                gs_vec3 forward = gs_vec3_norm(vc->velocity);
                                 tc->xform.rotation = gs_quat_from_to_rotation(gs_vec3_scale(GS_ZAXIS, -1.f), dir);
 
                                 // Change owner of projectile to player
                                 bc->owner = BSF_OWNER_PLAYER;
 
                                 // Change velocity based on hit normal, scale by previous magnitude for speed
-                                pc->velocity = gs_vec3_scale(dir, gs_vec3_len(pc->velocity));
+                                vc->velocity = gs_vec3_scale(dir, gs_vec3_len(vc->velocity));
                             }
                             else
                             {
                                 // Shake camera
                                 bsf_camera_shake(bsf, &bsf->scene.camera, 1.f);
+                                bsf_particles_emit(&bsf->particles, BSF_PARTICLE_IMPACT, tc->xform.translation, 2.f);
 
                                 // Hurt player
                                 bsf_player_damage(bsf, it->world, 0.5f);
@@ -3460,9 +7585,9 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it)
 				{
 					ecs_entity_t mob = room->mobs[m]; 
 					bsf_component_transform_t* tform = ecs_get(bsf->entities.world, mob, bsf_component_transform_t);
-					bsf_component_physics_t* phys = ecs_get(bsf->entities.world, mob, bsf_component_physics_t); 
+					bsf_component_collider_t* col = ecs_get(bsf->entities.world, mob, bsf_component_collider_t); 
 
-					gs_contact_info_t res = bsf_component_physics_collide(pc, &tc->xform, phys, 
+					gs_contact_info_t res = bsf_component_physics_collide(cc, &tc->xform, col, 
 							&tform->xform); 
 
 					if (res.hit)
@@ -3486,12 +7611,12 @@ GS_API_DECL void bsf_projectile_system(ecs_iter_t* it)
 GS_API_DECL void bsf_player_init(struct bsf_t* bsf)
 { 
     // This should all be initialized based on what the run context actually is
-    gs_gfxt_material_t* mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.ship_arwing"));
-    gs_gfxt_mesh_t* mesh = gs_hash_table_getp(bsf->assets.meshes, gs_hash_str64("mesh.arwing"));
-    gs_gfxt_texture_t* tex = gs_hash_table_getp(bsf->assets.textures, gs_hash_str64("tex.arwing"));
-    gs_gfxt_material_t* gsi_mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.gsi"));
-    gs_gfxt_material_set_uniform(mat, "u_tex", tex); 
-    gs_gfxt_material_set_uniform(mat, "u_color", &(gs_vec3){1.f, 1.f, 1.f}); 
+    gs_gfxt_material_t* mat = bsf->assets.hndl.mat_ship_arwing;
+    gs_gfxt_mesh_t* mesh = bsf->assets.hndl.mesh_arwing;
+    gs_gfxt_texture_t* tex = bsf->assets.hndl.tex_arwing;
+    gs_gfxt_material_t* gsi_mat = bsf->assets.hndl.mat_gsi;
+    BSF_MATERIAL_SET_UNIFORM(&bsf->assets, mat, u_tex, tex); 
+    BSF_MATERIAL_SET_UNIFORM(&bsf->assets, mat, u_color, &(gs_vec3){1.f, 1.f, 1.f}); 
 
     bsf->entities.player = ecs_new(bsf->entities.world, 0); 
     ecs_entity_t p = bsf->entities.player;
@@ -3530,9 +7655,12 @@ GS_API_DECL void bsf_player_init(struct bsf_t* bsf)
         })
     }); 
 
-    ecs_set(bsf->entities.world, p, bsf_component_physics_t, {
+    ecs_set(bsf->entities.world, p, bsf_component_velocity_t, {
         .velocity = gs_v3(0.f, 0.f, -0.01f), 
-        .speed = 3,
+        .speed = 3
+    });
+
+    ecs_set(bsf->entities.world, p, bsf_component_collider_t, {
         .collider = {
             .xform = (gs_vqs) {
                 .translation = gs_v3(0.f, 0.f, 2.f),
@@ -3561,13 +7689,14 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
     const gs_platform_gamepad_t* gp = &input->gamepads[0];
     bsf_component_renderable_t* rca = ecs_term(it, bsf_component_renderable_t, 1);
     bsf_component_transform_t* tca = ecs_term(it, bsf_component_transform_t, 2);
-    bsf_component_physics_t* pca = ecs_term(it, bsf_component_physics_t, 3); 
+    bsf_component_velocity_t* vca = ecs_term(it, bsf_component_velocity_t, 3); 
     bsf_component_character_stats_t* psca = ecs_term(it, bsf_component_character_stats_t, 4);
     bsf_component_health_t* hca = ecs_term(it, bsf_component_health_t, 5);
     bsf_component_gun_t* gca = ecs_term(it, bsf_component_gun_t, 6);
     bsf_component_camera_track_t* cca = ecs_term(it, bsf_component_camera_track_t, 7);
     bsf_component_barrel_roll_t* bca = ecs_term(it, bsf_component_barrel_roll_t, 8);
     bsf_component_inventory_t* ica = ecs_term(it, bsf_component_inventory_t, 9);
+    bsf_component_collider_t* pcca = ecs_term(it, bsf_component_collider_t, 10);
 
     const float gp_thresh = 0.2f;
 
@@ -3596,20 +7725,21 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
     { 
         bsf_component_renderable_t* rc = &rca[i];
         bsf_component_transform_t* tc = &tca[i];
-        bsf_component_physics_t* pc = &pca[i]; 
+        bsf_component_velocity_t* vc = &vca[i]; 
         bsf_component_character_stats_t* psc = &psca[i];
         bsf_component_health_t* hc = &hca[i];
         bsf_component_gun_t* gc = &gca[i];
         bsf_component_camera_track_t* cc = &cca[i];
         bsf_component_barrel_roll_t* bc = &bca[i];
         bsf_component_inventory_t* ic = &ica[i];
+        bsf_component_collider_t* pcc = &pcca[i];
 
-        pc->speed = mod * psc->speed * dt;
+        vc->speed = mod * psc->speed * dt;
 
         // Change physics shape based on whether or not barrel roll is active
         if (bc->active)
         {
-            pc->collider = (bsf_physics_collider_t) {
+            pcc->collider = (bsf_physics_collider_t) {
                 .type = BSF_COLLIDER_SPHERE,
                 .xform = (gs_vqs) {
                     .translation = gs_v3s(0.f),
@@ -3624,7 +7754,7 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
         }
         else
         {
-            pc->collider = (bsf_physics_collider_t){
+            pcc->collider = (bsf_physics_collider_t){
                 .type = BSF_COLLIDER_AABB,
                 .xform = (gs_vqs) {
                     .translation = gs_v3(0.f, 0.f, 2.f),
@@ -3663,16 +7793,16 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
             { 
                 // Normalize velocity then scale by player speed 
                 v = gp->present ? v : gs_vec3_norm(v);
-                v = gs_vec3_scale(v, pc->speed * mod * 150.f * dt);
+                v = gs_vec3_scale(v, vc->speed * mod * 150.f * dt);
 
                 // Forward impulse
                 gs_vec3 forward = gs_quat_rotate(tc->xform.rotation, gs_vec3_scale(GS_ZAXIS, -1.f)); 
 
-                pc->velocity = gs_vec3_add(
-                        gs_vec3_scale(gs_vec3_norm(forward), pc->speed),
+                vc->velocity = gs_vec3_add(
+                        gs_vec3_scale(gs_vec3_norm(forward), vc->speed),
                         gs_vec3_scale(gs_vec3_norm(gs_quat_rotate(cc->xform.rotation, GS_XAXIS)), mod_lr * 0.1f)
                 );
-                gs_vec3 pnp = gs_vec3_add(tc->xform.position, pc->velocity);
+                gs_vec3 pnp = gs_vec3_add(tc->xform.position, vc->velocity);
                 tc->xform.position = gs_v3(
                     gs_interp_linear(tc->xform.position.x, pnp.x, 0.98f),
                     gs_interp_linear(tc->xform.position.y, pnp.y, 0.98f),
@@ -3741,7 +7871,7 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
                     bc->time = 0.f;
                     bc->direction = -1;
                     bc->vel_dir = 1;
-                    bc->avz = pc->angular_velocity.z;
+                    bc->avz = vc->angular_velocity.z;
                     bc->max_time = 0.5f;
                 }
                 else if (double_click_left && !bc->active)
@@ -3750,7 +7880,7 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
                     bc->time = 0.f;
                     bc->direction = 1;
                     bc->vel_dir = -1;
-                    bc->avz = pc->angular_velocity.z;
+                    bc->avz = vc->angular_velocity.z;
                     bc->max_time = 0.5f;
                 } 
 
@@ -3761,7 +7891,7 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
                     bc->time = 0.f;
                     bc->direction = av.z >= 0.f ? 1 : -1;
                     bc->vel_dir = av.z < 0.f ? 1 : av.z > 0.f ? -1 : 0;
-                    bc->avz = pc->angular_velocity.z;
+                    bc->avz = vc->angular_velocity.z;
                     bc->max_time = 0.5f;
                 }
                 if (bc->active) 
@@ -3776,7 +7906,7 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
                 if (bc->time > bc->max_time && bc->active)
                 {
                     bc->active = false;
-                    pc->angular_velocity.z = bc->avz;
+                    vc->angular_velocity.z = bc->avz;
                 }
 
                 // Set camera track angular velocity
@@ -3799,14 +7929,14 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
 
                 // Add negated angular velocity to this
                 av.z = bc->active ? av.z * 50.f : av.z * 10.f;
-                av.z = av.z + pc->angular_velocity.z * -2.5f * dt;
+                av.z = av.z + vc->angular_velocity.z * -2.5f * dt;
 
-                gs_vec3* pav = &pc->angular_velocity;
-                gs_vec3 pnav = gs_vec3_add(pc->angular_velocity, av);
+                gs_vec3* pav = &vc->angular_velocity;
+                gs_vec3 pnav = gs_vec3_add(vc->angular_velocity, av);
                 *pav = gs_v3(
                     pnav.x, 
                     pnav.y, 
-                    bc->active ? brz : gs_interp_linear(pc->angular_velocity.z, gs_clamp(pnav.z, -max_rotz, max_rotz), 0.5f)
+                    bc->active ? brz : gs_interp_linear(vc->angular_velocity.z, gs_clamp(pnav.z, -max_rotz, max_rotz), 0.5f)
                 ); 
 
                 // Do rotation (need barrel roll rotation)
@@ -3822,18 +7952,18 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
             { 
                 // Normalize velocity then scale by player speed
                 v = gp->present ? v : gs_vec3_norm(v);
-                v = gs_vec3_scale(v, pc->speed * mod * 150.f * dt);
+                v = gs_vec3_scale(v, vc->speed * mod * 150.f * dt);
 
                 const float lerp = (ps->y >= yb.y && v.y < 0 || ps->y <= yb.x && v.y > 0 || ps->x >= xb.y && v.x < 0 || ps->x <= xb.x && v.x > 0) ? 0.2f : 0.1f;
 
                 // Add to velocity
-                pc->velocity = gs_v3(
-                    gs_interp_smoothstep(pc->velocity.x, v.x, lerp),
-                    gs_interp_smoothstep(pc->velocity.y, v.y, lerp),
-                    gs_interp_smoothstep(pc->velocity.z, v.z, lerp)
+                vc->velocity = gs_v3(
+                    gs_interp_smoothstep(vc->velocity.x, v.x, lerp),
+                    gs_interp_smoothstep(vc->velocity.y, v.y, lerp),
+                    gs_interp_smoothstep(vc->velocity.z, v.z, lerp)
                 );
 
-                gs_vec3 pnp = gs_vec3_add(tc->xform.position, pc->velocity);
+                gs_vec3 pnp = gs_vec3_add(tc->xform.position, vc->velocity);
                 pnp = gs_v3(
                     gs_clamp(pnp.x, xb.x, xb.y),
                     gs_clamp(pnp.y, yb.x, yb.y),
@@ -3904,7 +8034,7 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
                     bc->time = 0.f;
                     bc->direction = -1;
                     bc->vel_dir = 1;
-                    bc->avz = pc->angular_velocity.z;
+                    bc->avz = vc->angular_velocity.z;
                     bc->max_time = 0.5f;
                 }
                 else if (double_click_left && !bc->active)
@@ -3913,7 +8043,7 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
                     bc->time = 0.f;
                     bc->direction = 1;
                     bc->vel_dir = -1;
-                    bc->avz = pc->angular_velocity.z;
+                    bc->avz = vc->angular_velocity.z;
                     bc->max_time = 0.5f;
                 } 
 
@@ -3924,7 +8054,7 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
                     bc->time = 0.f;
                     bc->direction = av.z >= 0.f ? 1 : -1;
                     bc->vel_dir = av.z < 0.f ? 1 : av.z > 0.f ? -1 : 0;
-                    bc->avz = pc->angular_velocity.z;
+                    bc->avz = vc->angular_velocity.z;
                     bc->max_time = 0.5f;
                 }
                 if (bc->active) 
@@ -3939,7 +8069,7 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
                 if (bc->time > bc->max_time && bc->active)
                 {
                     bc->active = false;
-                    pc->angular_velocity.z = bc->avz;
+                    vc->angular_velocity.z = bc->avz;
                 }
 
                 const float max_rotx = 30.f;
@@ -3948,11 +8078,11 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
 
                 // Add negated angular velocity to this
                 av.z = bc->active ? av.z * 50.f : av.z * 10.f; 
-                gs_vec3 nav = gs_vec3_scale(pc->angular_velocity, -2.5f * dt);
+                gs_vec3 nav = gs_vec3_scale(vc->angular_velocity, -2.5f * dt);
 
                 const float plerp = 0.45f;
-                gs_vec3* pav = &pc->angular_velocity;
-                gs_vec3 npav = pc->angular_velocity;
+                gs_vec3* pav = &vc->angular_velocity;
+                gs_vec3 npav = vc->angular_velocity;
                 pav->x = gs_clamp(gs_interp_smoothstep(pav->x, pav->x + av.x, plerp), -max_rotx, max_rotx);
                 pav->y = gs_clamp(gs_interp_smoothstep(pav->y, pav->y + av.y, plerp), -max_roty, max_roty);
                 pav->z = bc->active ? brz : gs_interp_smoothstep(pav->z, gs_clamp(pav->z + av.z, -max_rotz, max_rotz), plerp);
@@ -3974,13 +8104,16 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
         bsf_renderable_t* rend = gs_slot_array_getp(bsf->scene.renderables, rc->hndl);
         rend->model = gs_vqs_to_mat4(&tc->xform);
 
+        // Player has moved, refresh bounds before tests against it this frame
+        bsf_component_collider_bake(pcc, &tc->xform);
+
         for (uint32_t m = 0; m < gs_dyn_array_size(room->mobs); ++m)
         {
             ecs_entity_t mob = room->mobs[m]; 
             bsf_component_transform_t* mtc = ecs_get(bsf->entities.world, mob, bsf_component_transform_t);
-            bsf_component_physics_t* mpc = ecs_get(bsf->entities.world, mob, bsf_component_physics_t); 
+            bsf_component_collider_t* mcc = ecs_get(bsf->entities.world, mob, bsf_component_collider_t); 
 
-            gs_contact_info_t res = bsf_component_physics_collide(pc, &tc->xform, mpc, &mtc->xform); 
+            gs_contact_info_t res = bsf_component_physics_collide(pcc, &tc->xform, mcc, &mtc->xform); 
 
             if (res.hit)
             { 
@@ -4036,7 +8169,7 @@ GS_API_DECL void bsf_player_system(ecs_iter_t* it)
             }
 
             // Play sound 
-            bsf_play_sound(bsf, "audio.laser", 0.5f);
+            bsf_play_sound(bsf, bsf->assets.hndl.audio_laser, 0.5f);
 
             bsf_camera_shake(bsf, &bsf->scene.camera, 0.05f);
         }
@@ -4067,7 +8200,7 @@ GS_API_DECL void bsf_player_damage(struct bsf_t* bsf, ecs_world_t* world, float
 {
     bsf_component_health_t* hc = ecs_get(world, bsf->entities.player, bsf_component_health_t);
     hc->health -= damage; 
-    bsf_play_sound(bsf, "audio.arwing_hit", 0.3f);
+    bsf_play_sound(bsf, bsf->assets.hndl.audio_arwing_hit, 0.3f);
 
     if (hc->health <= 0.f) 
     {
@@ -4084,14 +8217,14 @@ GS_API_DECL void bsf_player_consumable_pickup(struct bsf_t* bsf, ecs_world_t* wo
             bsf_component_health_t* hc = ecs_get(world, bsf->entities.player, bsf_component_health_t);
 			bsf_component_character_stats_t* sc = ecs_get(world, bsf->entities.player, bsf_component_character_stats_t);
             hc->health = gs_min(hc->health + 0.5f, sc->health);
-            bsf_play_sound(bsf, "audio.health_pickup", 0.5f);
+            bsf_play_sound(bsf, bsf->assets.hndl.audio_health_pickup, 0.5f);
         } break;
 
         case BSF_CONSUMABLE_BOMB:
         {
             bsf_component_inventory_t* ic = ecs_get(world, bsf->entities.player, bsf_component_inventory_t);
             ic->bombs++; 
-            bsf_play_sound(bsf, "audio.bomb_pickup", 0.5f);
+            bsf_play_sound(bsf, bsf->assets.hndl.audio_bomb_pickup, 0.5f);
         } break;
     } 
 } 
@@ -4170,7 +8303,7 @@ GS_API_DECL void bsf_player_item_pickup(struct bsf_t* bsf, ecs_world_t* world, b
         } break;
     }
 
-    bsf_play_sound(bsf, "audio.health_pickup", 0.5f);
+    bsf_play_sound(bsf, bsf->assets.hndl.audio_health_pickup, 0.5f);
 
     // Take the item out of the available item pool 
     bsf_item_remove_from_pool(bsf, type);
@@ -4223,7 +8356,7 @@ static void bsf_game_setup_menu(struct bsf_t* bsf, const gs_gui_rect_t* parent)
             if (gs_gui_button_ex(gui, "Play", &(gs_gui_selector_desc_t){.classes = {"top_panel_item"}}, 0x00)) {
                 bsf->state = BSF_STATE_START;
                 bsf->run.is_playing = true;
-                bsf_play_sound(bsf, "audio.menu_select", 0.5f);
+                bsf_play_sound(bsf, bsf->assets.hndl.audio_menu_select, 0.5f);
             } 
         }); 
 
@@ -4254,7 +8387,7 @@ static void bsf_options_menu(struct bsf_t* bsf, const gs_gui_rect_t* parent)
             if (gs_gui_button_ex(gui, "Back", &(gs_gui_selector_desc_t){.classes ={"top_panel_item"}}, 0x00)) {
                 if (bsf->run.is_playing) bsf->state = BSF_STATE_PAUSE;
                 else                     bsf->state = BSF_STATE_MAIN_MENU;
-                bsf_play_sound(bsf, "audio.menu_select", 0.5f);
+                bsf_play_sound(bsf, bsf->assets.hndl.audio_menu_select, 0.5f);
             } 
         });
     }
@@ -4286,7 +8419,7 @@ static void bsf_main_menu(struct bsf_t* bsf, const gs_gui_rect_t* parent)
                 gs_uuid_t uuid = gs_platform_uuid_generate();
                 gs_platform_uuid_to_string(str, &uuid);
                 memcpy(bsf->run.seed, str, BSF_SEED_MAX_LEN - 1);
-                bsf_play_sound(bsf, "audio.menu_select", 0.5f);
+                bsf_play_sound(bsf, bsf->assets.hndl.audio_menu_select, 0.5f);
             } 
         });
 
@@ -4294,7 +8427,7 @@ static void bsf_main_menu(struct bsf_t* bsf, const gs_gui_rect_t* parent)
             if (gs_gui_button(gui, "Editor"))
             {
                 bsf->state = BSF_STATE_EDITOR_START;
-                bsf_play_sound(bsf, "audio.menu_select", 0.5f);
+                bsf_play_sound(bsf, bsf->assets.hndl.audio_menu_select, 0.5f);
             }
         });
 
@@ -4302,7 +8435,7 @@ static void bsf_main_menu(struct bsf_t* bsf, const gs_gui_rect_t* parent)
             if (gs_gui_button(gui, "Options"))
             {
                 bsf->state = BSF_STATE_OPTIONS;
-                bsf_play_sound(bsf, "audio.menu_select", 0.5f);
+                bsf_play_sound(bsf, bsf->assets.hndl.audio_menu_select, 0.5f);
             }
         });
 
@@ -4319,7 +8452,7 @@ static void bsf_main_menu(struct bsf_t* bsf, const gs_gui_rect_t* parent)
             if (gs_gui_button(gui, "Quit"))
             {
                 bsf->state = BSF_STATE_QUIT; 
-                bsf_play_sound(bsf, "audio.menu_select", 0.5f);
+                bsf_play_sound(bsf, bsf->assets.hndl.audio_menu_select, 0.5f);
             }
         });
     }
@@ -4327,6 +8460,15 @@ static void bsf_main_menu(struct bsf_t* bsf, const gs_gui_rect_t* parent)
 
 }
 
+// Fills the next layout rect to t in [0, 1]
+static void bsf_gui_progress_bar(gs_gui_context_t* gui, float t)
+{
+    gs_gui_rect_t r = gs_gui_layout_next(gui);
+    gs_gui_draw_rect(gui, r, GS_COLOR_BLACK);
+    r.w *= gs_clamp(t, 0.f, 1.f);
+    gs_gui_draw_rect(gui, r, GS_COLOR_WHITE);
+}
+
 static void bsf_title_screen(struct bsf_t* bsf, const gs_gui_rect_t* parent)
 {
     gs_gui_context_t* gui = &bsf->gs.gui;
@@ -4361,7 +8503,13 @@ static void bsf_title_screen(struct bsf_t* bsf, const gs_gui_rect_t* parent)
             input->gamepads[0].buttons[GS_PLATFORM_GAMEPAD_BUTTON_START] || 
             input->gamepads[0].buttons[GS_PLATFORM_GAMEPAD_BUTTON_A]) {
             bsf->state = BSF_STATE_MAIN_MENU;
-            bsf_play_sound(bsf, "audio.start", 0.5f);
+            bsf_play_sound(bsf, bsf->assets.hndl.audio_start, 0.5f);
+        }
+
+        // Rest of the assets streaming in behind the menus
+        if (!bsf_assets_loaded(&bsf->assets)) {
+            gs_gui_layout_row(gui, 1, (int[]){-1}, 4);
+            bsf_gui_progress_bar(gui, bsf_assets_progress(&bsf->assets));
         }
     }
     gs_gui_panel_end(gui); 
@@ -4390,9 +8538,9 @@ GS_API_DECL void bsf_menu_update(struct bsf_t* bsf)
     const gs_vec2 fbs = gs_platform_framebuffer_sizev(gs_platform_main_window()); 
 
     // Assets
-    const gs_gui_style_sheet_t* ss = gs_hash_table_getp(bsf->assets.style_sheets, gs_hash_str64("ss.title")); 
-    const gs_gfxt_texture_t* title_bg = gs_hash_table_getp(bsf->assets.textures, gs_hash_str64("tex.title_bg"));
-    const gs_gfxt_texture_t* vignette = gs_hash_table_getp(bsf->assets.textures, gs_hash_str64("tex.vignette"));
+    const gs_gui_style_sheet_t* ss = bsf->assets.hndl.ss_title; 
+    const gs_gfxt_texture_t* title_bg = bsf->assets.hndl.tex_title_bg;
+    const gs_gfxt_texture_t* vignette = bsf->assets.hndl.tex_vignette;
 
     // Reset style sheet to default at top of frame
     gs_gui_set_style_sheet(gui, NULL);
@@ -4480,9 +8628,16 @@ GS_API_DECL void bsf_menu_update(struct bsf_t* bsf)
             if (gs_gui_button(gui, "Resume"))
             {
                 bsf->state = BSF_STATE_PLAY;
-                bsf_play_sound(bsf, "audio.start", 0.5f);
+                bsf_play_sound(bsf, bsf->assets.hndl.audio_start, 0.5f);
             } 
 
+            if (bsf->run.snapshot.world && gs_gui_button(gui, "Retry Room"))
+            {
+                bsf_room_snapshot_restore(bsf);
+                bsf->state = BSF_STATE_PLAY;
+                bsf_play_sound(bsf, bsf->assets.hndl.audio_start, 0.5f);
+            }
+
             if (gs_gui_button(gui, "Options"))
             {
                 bsf->state = BSF_STATE_OPTIONS;
@@ -4491,7 +8646,7 @@ GS_API_DECL void bsf_menu_update(struct bsf_t* bsf)
             if (gs_gui_button(gui, "Exit"))
             {
                 bsf->state = BSF_STATE_END;
-                bsf_play_music(bsf, "audio.music_title");
+                bsf_play_music(bsf, bsf->assets.hndl.music_title);
             }
 
             gs_gui_window_end(gui);
@@ -4500,6 +8655,25 @@ GS_API_DECL void bsf_menu_update(struct bsf_t* bsf)
     }
 } 
 
+GS_API_DECL void bsf_loading_update(struct bsf_t* bsf)
+{
+    gs_gui_context_t* gui = &bsf->gs.gui;
+    const gs_vec2 fbs = gs_platform_framebuffer_sizev(gs_platform_main_window()); 
+    const gs_vec2 ws = {400.f, 60.f};
+
+    gs_gui_set_style_sheet(gui, NULL);
+    gs_gui_window_begin_ex(gui, "##loading", gs_gui_rect((fbs.x - ws.x) * 0.5f, (fbs.y - ws.y) * 0.5f, ws.x, ws.y), NULL, NULL, 
+        GS_GUI_OPT_NOTITLE | GS_GUI_OPT_NOMOVE | GS_GUI_OPT_NOSCROLL | GS_GUI_OPT_NORESIZE); 
+    {
+        const float t = bsf_assets_progress(&bsf->assets);
+        gs_gui_layout_row(gui, 1, (int[]){-1}, 0);
+        gs_gui_label(gui, "Loading %.0f%%", t * 100.f);
+        gs_gui_layout_row(gui, 1, (int[]){-1}, 8);
+        bsf_gui_progress_bar(gui, t);
+    }
+    gs_gui_window_end(gui);
+}
+
 //=== BSF Game ===//
 
 static uint32_t bsf_game_room_get_cell(uint32_t row, uint32_t col)
@@ -4697,8 +8871,114 @@ static int32_t bsf_game_room_compare(void* cp0, void* cp1)
     return (r0->distance > r1->distance);
 }
 
+GS_API_DECL void bsf_room_add_entity(struct bsf_t* bsf, bsf_room_t* room, ecs_entity_t e)
+{
+    // Lazily create room parent, all spawned entities are parented to it so the room unloads with a single delete
+    if (!room->root) {
+        room->root = ecs_new(bsf->entities.world, 0);
+    }
+    ecs_add_pair(bsf->entities.world, e, EcsChildOf, room->root);
+}
+
+GS_API_DECL void bsf_room_unload(struct bsf_t* bsf, bsf_room_t* room)
+{
+    // Deleting the room parent deletes its tables, which the room snapshot still points at
+    bsf_room_snapshot_free(bsf);
+
+    // Deleting the parent cascades to all children table by table (dtors receive whole batches)
+    if (room->root) {
+        ecs_delete(bsf->entities.world, room->root);
+        room->root = 0;
+    }
+
+    gs_dyn_array_clear(room->mobs);
+    gs_dyn_array_clear(room->obstacles);
+    gs_dyn_array_clear(room->consumables);
+    gs_dyn_array_clear(room->items);
+}
+
+GS_API_DECL void bsf_room_snapshot_take(struct bsf_t* bsf)
+{
+    bsf_room_snapshot_t* snap = &bsf->run.snapshot;
+    bsf_room_t* room = gs_slot_array_getp(bsf->run.rooms, bsf->run.room_ids[bsf->run.cell]);
+
+    bsf_room_snapshot_free(bsf);
+
+    snap->world = bsf_entities_snapshot_take(bsf, &snap->size, &snap->count);
+    snap->rand = bsf->run.rand;
+    snap->boss = bsf->entities.boss;
+
+    // Copy room, entity lists need their own storage
+    snap->room = *room;
+    snap->room.mobs = NULL;
+    snap->room.obstacles = NULL;
+    snap->room.consumables = NULL;
+    snap->room.items = NULL;
+    for (uint32_t i = 0; i < gs_dyn_array_size(room->mobs); ++i)           gs_dyn_array_push(snap->room.mobs, room->mobs[i]);
+    for (uint32_t i = 0; i < gs_dyn_array_size(room->obstacles); ++i)      gs_dyn_array_push(snap->room.obstacles, room->obstacles[i]);
+    for (uint32_t i = 0; i < gs_dyn_array_size(room->consumables); ++i)    gs_dyn_array_push(snap->room.consumables, room->consumables[i]);
+    for (uint32_t i = 0; i < gs_dyn_array_size(room->items); ++i)          gs_dyn_array_push(snap->room.items, room->items[i]);
+    for (uint32_t i = 0; i < gs_dyn_array_size(bsf->run.item_pool); ++i)   gs_dyn_array_push(snap->item_pool, bsf->run.item_pool[i]);
+
+    gs_println("Room snapshot: %u entities, %zu bytes", snap->count, snap->size);
+}
+
+GS_API_DECL void bsf_room_snapshot_restore(struct bsf_t* bsf)
+{
+    bsf_room_snapshot_t* snap = &bsf->run.snapshot;
+    if (!snap->world) return;
+
+    bsf_room_t* room = gs_slot_array_getp(bsf->run.rooms, bsf->run.room_ids[bsf->run.cell]);
+
+    // Restore consumes the world snapshot, retake it so the room can be retried again
+    bsf_entities_snapshot_restore(bsf, snap->world);
+    snap->world = bsf_entities_snapshot_take(bsf, NULL, NULL);
+
+    gs_dyn_array_clear(room->mobs);
+    gs_dyn_array_clear(room->obstacles);
+    gs_dyn_array_clear(room->consumables);
+    gs_dyn_array_clear(room->items);
+    gs_dyn_array_clear(bsf->run.item_pool);
+    for (uint32_t i = 0; i < gs_dyn_array_size(snap->room.mobs); ++i)          gs_dyn_array_push(room->mobs, snap->room.mobs[i]);
+    for (uint32_t i = 0; i < gs_dyn_array_size(snap->room.obstacles); ++i)     gs_dyn_array_push(room->obstacles, snap->room.obstacles[i]);
+    for (uint32_t i = 0; i < gs_dyn_array_size(snap->room.consumables); ++i)   gs_dyn_array_push(room->consumables, snap->room.consumables[i]);
+    for (uint32_t i = 0; i < gs_dyn_array_size(snap->room.items); ++i)         gs_dyn_array_push(room->items, snap->room.items[i]);
+    for (uint32_t i = 0; i < gs_dyn_array_size(snap->item_pool); ++i)          gs_dyn_array_push(bsf->run.item_pool, snap->item_pool[i]);
+
+    room->root = snap->room.root;
+    room->cleared = snap->room.cleared;
+    room->movement_type = snap->room.movement_type;
+
+    bsf->run.rand = snap->rand;
+    bsf->entities.boss = snap->boss;
+    bsf->run.time_scale = 1.f;
+    bsf->run.just_cleared_room = false;
+    bsf->run.just_cleared_level = false;
+    bsf->run.complete = false;
+    bsf->run.clear_timer = 0.f;
+
+    bsf_camera_init(bsf, &bsf->scene.camera);
+}
+
+GS_API_DECL void bsf_room_snapshot_free(struct bsf_t* bsf)
+{
+    bsf_room_snapshot_t* snap = &bsf->run.snapshot;
+    if (!snap->world) return;
+
+    // Dtors release the snapshot's hidden renderables
+    ecs_snapshot_free(snap->world);
+    gs_dyn_array_free(snap->room.mobs);
+    gs_dyn_array_free(snap->room.obstacles);
+    gs_dyn_array_free(snap->room.consumables);
+    gs_dyn_array_free(snap->room.items);
+    gs_dyn_array_free(snap->item_pool);
+    memset(snap, 0, sizeof(bsf_room_snapshot_t));
+}
+
 GS_API_DECL void bsf_room_load(struct bsf_t* bsf, uint32_t cell)
 {
+    bsf_particles_clear(&bsf->particles);
+
     // Unload previous room cell of items, mobs, obstacles
     for (
         gs_slot_array_iter it = gs_slot_array_iter_new(bsf->run.rooms); 
@@ -4707,26 +8987,7 @@ GS_API_DECL void bsf_room_load(struct bsf_t* bsf, uint32_t cell)
     )
     {
         bsf_room_t* room = gs_slot_array_iter_getp(bsf->run.rooms, it); 
-        for (uint32_t i = 0; i < gs_dyn_array_size(room->mobs); ++i) {
-            ecs_delete(bsf->entities.world, room->mobs[i]);
-        }
-
-        for (uint32_t i = 0; i < gs_dyn_array_size(room->obstacles); ++i) {
-            ecs_delete(bsf->entities.world, room->obstacles[i]);
-        }
-
-        for (uint32_t i = 0; i < gs_dyn_array_size(room->consumables); ++i) {
-            ecs_delete(bsf->entities.world, room->consumables[i]);
-        }
-
-        for (uint32_t i = 0; i < gs_dyn_array_size(room->items); ++i) {
-            ecs_delete(bsf->entities.world, room->items[i]);
-        }
-
-        gs_dyn_array_clear(room->mobs);
-        gs_dyn_array_clear(room->obstacles);
-        gs_dyn_array_clear(room->consumables);
-        gs_dyn_array_clear(room->items);
+        bsf_room_unload(bsf, room);
     }
 
     gs_println("Loading room: %zu", cell);
@@ -4788,6 +9049,7 @@ GS_API_DECL void bsf_room_load(struct bsf_t* bsf, uint32_t cell)
 				// Have to verify that this item isn't taken yet...
 				ecs_entity_t e = bsf_item_chest_create(bsf, &xform, type);
 				gs_dyn_array_push(room->items, e);
+				bsf_room_add_entity(bsf, room, e);
 
 				// Add to item pool
 				gs_dyn_array_push(bsf->run.item_pool, type); 
@@ -4803,10 +9065,11 @@ GS_API_DECL void bsf_room_load(struct bsf_t* bsf, uint32_t cell)
             xform.translation.z = 10.f;
             ecs_entity_t e = bsf_mob_create(bsf, world, &xform, type);
             gs_dyn_array_push(room->mobs, e);
+            bsf_room_add_entity(bsf, room, e);
             bsf->entities.boss = e;
 
             // Play boss music
-            bsf_play_music(bsf, "audio.music_boss");
+            bsf_play_music(bsf, bsf->assets.hndl.music_boss);
         }break; 
 
         case BSF_ROOM_DEFAULT:
@@ -4839,6 +9102,7 @@ GS_API_DECL void bsf_room_load(struct bsf_t* bsf, uint32_t cell)
                         bsf_mob_type type = v % (uint64_t)BSF_MOB_BOSS;
                         ecs_entity_t e = bsf_mob_create(bsf, world, &brush->xform, type);
                         gs_dyn_array_push(room->mobs, e);
+                        bsf_room_add_entity(bsf, room, e);
                     } break;
 
                     case BSF_ROOM_BRUSH_BANDIT: 
@@ -4846,6 +9110,7 @@ GS_API_DECL void bsf_room_load(struct bsf_t* bsf, uint32_t cell)
                         bsf_mob_type type = BSF_MOB_BANDIT;
                         ecs_entity_t e = bsf_mob_create(bsf, world, &brush->xform, type);
                         gs_dyn_array_push(room->mobs, e);
+                        bsf_room_add_entity(bsf, room, e);
                     } break;
 
                     case BSF_ROOM_BRUSH_TURRET: 
@@ -4854,6 +9119,7 @@ GS_API_DECL void bsf_room_load(struct bsf_t* bsf, uint32_t cell)
                         bsf_mob_type type = BSF_MOB_TURRET;
                         ecs_entity_t e = bsf_mob_create(bsf, world, &brush->xform, type);
                         gs_dyn_array_push(room->mobs, e);
+                        bsf_room_add_entity(bsf, room, e);
                     } break;
 
                     case BSF_ROOM_BRUSH_CONSUMABLE:
@@ -4862,6 +9128,7 @@ GS_API_DECL void bsf_room_load(struct bsf_t* bsf, uint32_t cell)
                         bsf_consumable_type type = v % (uint64_t)BSF_CONSUMABLE_COUNT;
                         ecs_entity_t e = bsf_consumable_create(bsf, &brush->xform, type);
                         gs_dyn_array_push(room->consumables, e);
+                        bsf_room_add_entity(bsf, room, e);
                     } break;
 
                     case BSF_ROOM_BRUSH_OBSTACLE:
@@ -4880,12 +9147,15 @@ GS_API_DECL void bsf_room_load(struct bsf_t* bsf, uint32_t cell)
 
                         ecs_entity_t e = bsf_obstacle_create(bsf, &xform, type);
                         gs_dyn_array_push(room->obstacles, e);
+                        bsf_room_add_entity(bsf, room, e);
                     } break; 
 				}
 			} 
         } break; 
     }
 
+    // Capture room entry for retries
+    bsf_room_snapshot_take(bsf);
 }
 
 static void bsf_game_level_gen(struct bsf_t* bsf)
@@ -4941,22 +9211,7 @@ static void bsf_game_level_gen(struct bsf_t* bsf)
     )
     {
         bsf_room_t* room = gs_slot_array_iter_getp(bsf->run.rooms, it); 
-        for (uint32_t i = 0; i < gs_dyn_array_size(room->mobs); ++i) {
-            ecs_delete(bsf->entities.world, room->mobs[i]);
-        }
-        for (uint32_t i = 0; i < gs_dyn_array_size(room->items); ++i) {
-            ecs_delete(bsf->entities.world, room->items[i]);
-        }
-        for (uint32_t i = 0; i < gs_dyn_array_size(room->obstacles); ++i) {
-            ecs_delete(bsf->entities.world, room->obstacles[i]);
-        }
-        for (uint32_t i = 0; i < gs_dyn_array_size(room->consumables); ++i) {
-            ecs_delete(bsf->entities.world, room->consumables[i]);
-        }
-        gs_dyn_array_clear(room->mobs);
-        gs_dyn_array_clear(room->items);
-        gs_dyn_array_clear(room->obstacles);
-        gs_dyn_array_clear(room->consumables);
+        bsf_room_unload(bsf, room);
         room->cleared = false;
     } 
 
@@ -5126,64 +9381,238 @@ GS_API_DECL void bsf_game_start(struct bsf_t* bsf)
     bsf->run.complete = false;
     bsf->run.clear_timer = 0.f;
 
+    // Add room entity (before level gen so it is part of the first room snapshot)
+    bsf_game_add_room_entity(bsf);
+
     // Initialize world based on seed
     bsf_game_level_gen(bsf);
 
-    // Add room entity
-    bsf_game_add_room_entity(bsf);
-
     gs_platform_lock_mouse(gs_platform_main_window(), true);
 
     // Set state to playing game
     bsf->state = BSF_STATE_PLAY;
 
     // Start level music
-    bsf_play_music(bsf, "audio.music_level");
+    bsf_play_music(bsf, bsf->assets.hndl.music_level);
 }
 
 GS_API_DECL void bsf_game_end(struct bsf_t* bsf)
 { 
-	// Destroy entity world
-	ecs_fini(bsf->entities.world);
+	// Reset entity world back to its registered, empty state
+	bsf_entities_reset(bsf);
+
+    // Room parents/entities belonged to the reset world
+    for (
+        gs_slot_array_iter it = gs_slot_array_iter_new(bsf->run.rooms);
+        gs_slot_array_iter_valid(bsf->run.rooms, it);
+        gs_slot_array_iter_advance(bsf->run.rooms, it)
+    )
+    {
+        bsf_room_t* room = gs_slot_array_iter_getp(bsf->run.rooms, it); 
+        room->root = 0;
+        gs_dyn_array_clear(room->mobs);
+        gs_dyn_array_clear(room->obstacles);
+        gs_dyn_array_clear(room->consumables);
+        gs_dyn_array_clear(room->items);
+    }
 
     bsf->run.is_playing = false;
     bsf->state = BSF_STATE_MAIN_MENU;
 }
 
-GS_API_DECL void bsf_play_music(struct bsf_t* bsf, const char* key)
+GS_API_DECL void bsf_play_music(struct bsf_t* bsf, const bsf_music_track_t* track)
 {
-    uint64_t hash = gs_hash_str64(key);
-    gs_asset_audio_t* src = gs_hash_table_getp(bsf->assets.sounds, hash);
-    gs_assert(src);
-    gs_audio_stop(bsf->music);
-    if (!gs_handle_is_valid(bsf->music)) {
-        gs_println("CREATING INSTANCE DATA");
-        bsf->music = gs_audio_instance_create(&(gs_audio_instance_decl_t) {
-            .src = src->hndl, 
-            .volume = 0.7f, 
-            .loop = true, 
-            .persistent = false
-        });
+    gs_assert(track);
+    bsf_music_t* music = &bsf->music;
+    if (!music->running) {
+        return;
     }
-    else
+    ma_mutex_lock(&music->lock);
+    music->pending = track;
+    ma_mutex_unlock(&music->lock);
+}
+
+static void bsf_music_device_cb(ma_device* device, void* output, const void* input, ma_uint32 frame_count)
+{
+    // Whatever isn't decoded yet plays as silence (device buffer is zeroed)
+    bsf_music_t* music = (bsf_music_t*)device->pUserData;
+    float* out = (float*)output;
+    while (frame_count)
     {
-        gs_println("SETTING INSTANCE DATA");
-        gs_audio_set_instance_data(bsf->music, (gs_audio_instance_decl_t) {
-            .src = src->hndl, 
-            .volume = 0.7f, 
-            .loop = true,
-            .persistent = false,
-            .sample_position = 0
-        });
+        ma_uint32 frames = frame_count;
+        void* data = NULL;
+        if (ma_pcm_rb_acquire_read(&music->ring, &frames, &data) != MA_SUCCESS || !frames) break;
+        memcpy(out, data, frames * BSF_MUSIC_CHANNELS * sizeof(float));
+        ma_pcm_rb_commit_read(&music->ring, frames, data);
+        out += frames * BSF_MUSIC_CHANNELS;
+        frame_count -= frames;
+    }
+}
+
+// Reads frames from a track, looping at its end
+static uint32_t bsf_music_read(ma_decoder* decoder, float* out, uint32_t frames)
+{
+    uint32_t read = 0;
+    for (uint32_t tries = 0; read < frames && tries < 2; ++tries)
+    {
+        ma_uint64 got = ma_decoder_read_pcm_frames(decoder, out + read * BSF_MUSIC_CHANNELS, frames - read);
+        read += (uint32_t)got;
+        if (read < frames) {
+            ma_decoder_seek_to_pcm_frame(decoder, 0);
+        }
+    }
+    return read;
+}
+
+// Decodes (and mixes while crossfading) as much as fits into the ring buffer
+static void bsf_music_fill(bsf_music_t* music)
+{
+    ma_mutex_lock(&music->lock);
+    const bsf_music_track_t* pending = music->pending;
+    music->pending = NULL;
+    ma_mutex_unlock(&music->lock);
+
+    if (pending)
+    {
+        // Incoming track goes in the free slot, a third request mid fade replaces the incoming one
+        const uint32_t slot = music->open[music->current] ? music->current ^ 1 : music->current;
+        if (music->open[slot]) {
+            ma_decoder_uninit(&music->decoders[slot]);
+            music->open[slot] = false;
+        }
+        ma_decoder_config cfg = ma_decoder_config_init(ma_format_f32, BSF_MUSIC_CHANNELS, music->device.sampleRate);
+        music->open[slot] = ma_decoder_init_file(pending->path, &cfg, &music->decoders[slot]) == MA_SUCCESS;
+        if (!music->open[slot]) {
+            gs_println("Warning: BSF::Unable to open music: %s", pending->path);
+        }
+        music->fade = slot == music->current ? music->fade_frames : 0;
+    }
+
+    const uint32_t cur = music->current, next = cur ^ 1;
+    float* a = music->mix;
+    float* b = music->mix + BSF_MUSIC_CHUNK_FRAMES * BSF_MUSIC_CHANNELS;
+    for (;;)
+    {
+        ma_uint32 frames = gs_min(ma_pcm_rb_available_write(&music->ring), BSF_MUSIC_CHUNK_FRAMES);
+        if (!frames) break;
+
+        memset(a, 0, frames * BSF_MUSIC_CHANNELS * sizeof(float));
+        if (music->open[cur]) {
+            bsf_music_read(&music->decoders[cur], a, frames);
+        }
+
+        const bool32 fading = music->fade < music->fade_frames;
+        if (fading)
+        {
+            memset(b, 0, frames * BSF_MUSIC_CHANNELS * sizeof(float));
+            if (music->open[next]) {
+                bsf_music_read(&music->decoders[next], b, frames);
+            }
+            for (uint32_t f = 0; f < frames; ++f)
+            {
+                const float t = gs_min((float)(music->fade + f) / (float)music->fade_frames, 1.f);
+                for (uint32_t c = 0; c < BSF_MUSIC_CHANNELS; ++c) {
+                    const uint32_t i = f * BSF_MUSIC_CHANNELS + c;
+                    a[i] = a[i] * (1.f - t) + b[i] * t;
+                }
+            }
+            music->fade = gs_min(music->fade + frames, music->fade_frames);
+        }
+
+        for (uint32_t i = 0; i < frames * BSF_MUSIC_CHANNELS; ++i) {
+            a[i] *= BSF_MUSIC_VOLUME;
+        }
+
+        void* data = NULL;
+        ma_pcm_rb_acquire_write(&music->ring, &frames, &data);
+        memcpy(data, a, frames * BSF_MUSIC_CHANNELS * sizeof(float));
+        ma_pcm_rb_commit_write(&music->ring, frames, data);
+
+        // Fade done, incoming track becomes current
+        if (fading && music->fade >= music->fade_frames)
+        {
+            if (music->open[cur]) {
+                ma_decoder_uninit(&music->decoders[cur]);
+                music->open[cur] = false;
+            }
+            music->current = next;
+            break;
+        }
+    }
+}
+
+#ifdef BSF_JOB_THREADS
+static void* bsf_music_thread(void* data)
+{
+    bsf_music_t* music = (bsf_music_t*)data;
+    while (!BSF_ATOMIC_LOAD(&music->quit)) {
+        bsf_music_fill(music);
+        gs_platform_sleep(5.f);
+    }
+    return NULL;
+}
+#endif
+
+GS_API_DECL void bsf_music_init(bsf_music_t* music)
+{
+    memset(music, 0, sizeof(bsf_music_t));
+
+    ma_device_config cfg = ma_device_config_init(ma_device_type_playback);
+    cfg.playback.format = ma_format_f32;
+    cfg.playback.channels = BSF_MUSIC_CHANNELS;
+    cfg.sampleRate = 0;                         // Device native, decoders resample
+    cfg.dataCallback = bsf_music_device_cb;
+    cfg.pUserData = music;
+    if (ma_device_init(NULL, &cfg, &music->device) != MA_SUCCESS) {
+        gs_println("Warning: BSF::Unable to open music device, music disabled");
+        return;
+    }
+
+    ma_pcm_rb_init(ma_format_f32, BSF_MUSIC_CHANNELS, BSF_MUSIC_RING_FRAMES, NULL, NULL, &music->ring);
+    ma_mutex_init(&music->lock);
+    music->fade_frames = (uint32_t)(BSF_MUSIC_FADE * music->device.sampleRate);
+    music->fade = music->fade_frames;
+    music->running = true;
+
+#ifdef BSF_JOB_THREADS
+    pthread_create(&music->thread, NULL, bsf_music_thread, music);
+#endif
+    ma_device_start(&music->device);
+}
+
+GS_API_DECL void bsf_music_update(bsf_music_t* music)
+{
+#ifndef BSF_JOB_THREADS
+    if (music->running) {
+        bsf_music_fill(music);
+    }
+#endif
+}
+
+GS_API_DECL void bsf_music_free(bsf_music_t* music)
+{
+    if (!music->running) {
+        return;
     }
-    gs_audio_play(bsf->music);
+#ifdef BSF_JOB_THREADS
+    BSF_ATOMIC_STORE(&music->quit, true);
+    pthread_join(music->thread, NULL);
+#endif
+    ma_device_uninit(&music->device);
+    for (uint32_t i = 0; i < 2; ++i) {
+        if (music->open[i]) ma_decoder_uninit(&music->decoders[i]);
+    }
+    ma_pcm_rb_uninit(&music->ring);
+    ma_mutex_uninit(&music->lock);
+    memset(music, 0, sizeof(bsf_music_t));
 }
 
-GS_API_DECL void bsf_play_sound(struct bsf_t* bsf, const char* key, float volume)
+GS_API_DECL void bsf_play_sound(struct bsf_t* bsf, const gs_asset_audio_t* src, float volume)
 {
-    uint64_t hash = gs_hash_str64(key);
-    gs_asset_audio_t* src = gs_hash_table_getp(bsf->assets.sounds, hash);
     gs_assert(src);
+    if (!gs_handle_is_valid(src->hndl)) {
+        return;         // Still streaming in
+    }
     gs_audio_play_source(src->hndl, volume);
 }
 
@@ -5201,7 +9630,7 @@ void gui_cb(gs_gui_context_t* ctx, gs_gui_customcommand_t* cmd)
     gs_immediate_draw_t* gsi = &ctx->gsi;
     const float t = gs_platform_elapsed_time();
     const gs_vec2 fbs = gs_platform_framebuffer_sizev(gs_platform_main_window());
-    gs_gfxt_material_t* mat = gs_hash_table_getp(bsf->assets.materials, gs_hash_str64("mat.gsi"));
+    gs_gfxt_material_t* mat = bsf->assets.hndl.mat_gui;
     gs_gfxt_pipeline_t* pip = gs_gfxt_material_get_pipeline(mat); 
     gs_gui_id id = gs_gui_get_id_hash(ctx, "#ctrl", 5, cmd->hash); 
     gs_color_t col = cmd->hover == id ? GS_COLOR_RED : GS_COLOR_WHITE;
@@ -5216,7 +9645,7 @@ void gui_cb(gs_gui_context_t* ctx, gs_gui_customcommand_t* cmd)
     gsi_pop_matrix_ex(gsi, false); 
     gs_graphics_set_viewport(&gsi->commands, cmd->viewport.x, 
             fbs.y - cmd->viewport.h - cmd->viewport.y, cmd->viewport.w, cmd->viewport.h); 
-    gs_gfxt_material_set_uniform(mat, "u_mvp", &mvp);
+    BSF_MATERIAL_SET_UNIFORM(&bsf->assets, mat, u_mvp, &mvp);
     gs_gfxt_material_bind(&gsi->commands, mat);
     gs_gfxt_material_bind_uniforms(&gsi->commands, mat);
     gsi_flush(gsi);
@@ -5249,7 +9678,7 @@ GS_API_DECL void bsf_game_update(struct bsf_t* bsf)
 
     if (gs_platform_key_pressed(GS_KEYCODE_ESC)) {
         bsf->state = BSF_STATE_PAUSE;
-        bsf_play_sound(bsf, "audio.pause", 0.5f);
+        bsf_play_sound(bsf, bsf->assets.hndl.audio_pause, 0.5f);
         return;
     } 
 
@@ -5281,6 +9710,10 @@ GS_API_DECL void bsf_game_update(struct bsf_t* bsf)
     // Update entity world
     ecs_progress(bsf->entities.world, 0);
 
+    if (!bsf->dbg) {
+        bsf_particles_update(&bsf->particles, dt);
+    }
+
     // If all mobs cleared from room, then clear it
     const float time_max = 1.f;
     if (
@@ -5362,7 +9795,7 @@ GS_API_DECL void bsf_game_update(struct bsf_t* bsf)
     {
         bsf->run.just_cleared_level = false;
         bsf->run.complete = true;
-        bsf_play_music(bsf, "audio.music_level_complete");
+        bsf_play_music(bsf, bsf->assets.hndl.music_level_complete);
     }
 
     // If not in a boss room, we need to have obstacles that scroll by...depending on the room type
@@ -5499,9 +9932,9 @@ GS_API_DECL void bsf_game_update(struct bsf_t* bsf)
                     case BSF_OWNER_ENEMY:
                     {
                         const bsf_component_transform_t* tc = ecs_get(bsf->entities.world, b, bsf_component_transform_t);
-                        const bsf_component_physics_t* pc = ecs_get(bsf->entities.world, b, bsf_component_physics_t);
+                        const bsf_component_velocity_t* vc = ecs_get(bsf->entities.world, b, bsf_component_velocity_t);
                         gs_vec3 bp = tc->xform.translation; 
-                        gs_vec3 vel = pc->velocity;
+                        gs_vec3 vel = vc->velocity;
 
                         gs_vec3 dir = gs_vec3_norm(gs_vec3_sub(bp, bsf->scene.camera.cam.transform.translation));
                         gs_vec3 fwd = gs_vec3_norm(gs_camera_forward(&bsf->scene.camera.cam));
@@ -5608,12 +10041,21 @@ GS_API_DECL void bsf_game_update(struct bsf_t* bsf)
                     );
                     ecs_entity_t e = bsf_mob_create(bsf, bsf->entities.world, &xform, type);
                     gs_dyn_array_push(room->mobs, e);
+                    bsf_room_add_entity(bsf, room, e);
                 }
 
                 GUI_LABEL("level: %zu", bsf->run.level); 
                 GUI_LABEL("num_rooms: %zu", gs_slot_array_size(bsf->run.rooms)); 
                 GUI_LABEL("num_mobs: %zu", (u32)gs_dyn_array_size(room->mobs));
                 GUI_LABEL("num_renderables: %zu", gs_slot_array_size(bsf->scene.renderables));
+                GUI_LABEL("visible: %u, culled: %u", bsf->scene.stats.cull.visible, bsf->scene.stats.cull.culled);
+                GUI_LABEL("particles: %u", bsf->particles.count);
+                GUI_LABEL("encode: %.2fms", bsf->scene.stats.encode_ms);
+                GUI_LABEL("lods: %u/%u/%u/%u", bsf->scene.stats.queue.lods[0], bsf->scene.stats.queue.lods[1], 
+                    bsf->scene.stats.queue.lods[2], bsf->scene.stats.queue.lods[3]);
+                GUI_LABEL("draws: %u (%u instances), pip binds: %u, mesh binds: %u", bsf->scene.stats.queue.draws, 
+                    bsf->scene.stats.queue.instances, bsf->scene.stats.queue.pipeline_binds, bsf->scene.stats.queue.mesh_binds);
+                GUI_LABEL("snapshot: %u entities, %.2f kb", bsf->run.snapshot.count, (float)bsf->run.snapshot.size / 1024.f);
                 GUI_LABEL("active cell: %zu", bsf->run.cell);
                 GUI_LABEL("room cell: %zu", room->cell);
 
@@ -6091,7 +10533,7 @@ GS_API_DECL void bsf_editor(struct bsf_t* bsf)
         if (gs_gui_button(gui, "Exit"))
         {
             bsf->state = BSF_STATE_MAIN_MENU;
-            bsf_play_music(bsf, "audio.music_title");
+            bsf_play_music(bsf, bsf->assets.hndl.music_title);
         }
     }
 	gs_gui_window_end(gui);
@@ -6728,7 +11170,7 @@ GS_API_DECL void bsf_test(struct bsf_t* bsf)
         {
             bsf->state = BSF_STATE_MAIN_MENU;
             bsf_test_init = false; 
-            bsf_play_music(bsf, "audio.music_title");
+            bsf_play_music(bsf, bsf->assets.hndl.music_title);
         } 
 
 		// Curve parameters
@@ -0,0 +1,340 @@
+#!/usr/bin/env python3
+"""
+asset_pack.py: offline baker for the memory mapped asset pack (assets/bsf.pack)
+
+    python3 tools/asset_pack.py assets assets/bsf.pack meshes/laser_player.gltf=pipelines/color.sf
+
+Every texture in <asset_dir>/textures and every mesh in <asset_dir>/meshes is written pre-decoded:
+
+    - Images as RGBA8 rows, ready for gs_graphics_texture_create, or RGB8 when fully opaque (a quarter less
+      to map and upload). PNG is decoded here, JPEG needs Pillow (pip install pillow) and is left out of the
+      pack without it. Images with identical pixels are stored once, their entries share the payload.
+    - Meshes as one interleaved vertex buffer and index buffer per primitive in the mesh_layout of their
+      pipeline (pipelines/simple.sf unless mapped otherwise as <mesh>=<pipeline> on the command line),
+      plus the bounding sphere bsf_graphics_mesh_bounds_from_file would compute.
+    - Font atlases (glyphs, vertical metrics and coverage) as the game bakes them into its font cache
+      (<asset_dir>/fonts/<font>.ttf.<pt>.bsff), one entry per size under the path of the ttf. Rasterizing
+      needs stb_truetype, so run the game once before packing to have the atlases baked.
+
+Layout (little endian, must match bsf_asset_pack_* in main.c):
+
+    header      magic 'BSFP', version, entry count, reserved
+    entries     path[112], type, width, height, comps, offset (u64), size (u64),
+                source size (u64), source mtime (u64, seconds)
+    payloads    16 byte aligned (possibly shared by several entries), image: width * height * comps bytes
+                mesh: bounds[4], layout[48], index size, primitive count, 2 x pad,
+                      primitives x (vertex offset, vertex size, index offset, index size (u64), count, 3 x pad),
+                      vertex and index data (offsets relative to start of mesh payload)
+                font: the .bsff file as is (header, glyphs, metrics, coverage), comps holds the point size
+
+The game loads anything missing from the pack (or baked for a different layout) from the loose files.
+Entries record size and mtime of the file they were baked from (a mesh adds its <mesh>.bin, a font atlas
+records its ttf), the game loads the loose file instead of an entry whose source has changed since, until
+the pack is rebuilt.
+"""
+
+import json
+import math
+import os
+import re
+import struct
+import sys
+import zlib
+
+MAGIC = 0x50465342
+VERSION = 2
+ALIGN = 16
+
+TYPE_IMAGE = 1
+TYPE_MESH = 2
+TYPE_FONT = 3
+
+FONT_MAGIC = 0x46465342
+FONT_VERSION = 1
+FONT_HEADER_FMT = "<2IQ4I"
+
+ENTRY_FMT = "<112s4I4Q"
+MESH_FMT = "<4f48s2I2I"
+PRIM_FMT = "<4Q4I"
+
+COMPONENTS = {"SCALAR": 1, "VEC2": 2, "VEC3": 3, "VEC4": 4}
+FORMATS = {5121: "B", 5123: "H", 5125: "I", 5126: "f"}
+
+# Vertex format of each mesh_layout semantic as gs_gfxt lays it out, and the value used when a mesh lacks it
+SEMANTICS = {
+    "POSITION": ("POSITION", "<3f", (0.0, 0.0, 0.0)),
+    "NORMAL": ("NORMAL", "<3f", (0.0, 0.0, 1.0)),
+    "TANGENT": ("TANGENT", "<4f", (1.0, 0.0, 0.0, 1.0)),
+    "TEXCOORD": ("TEXCOORD_0", "<2f", (0.0, 0.0)),
+    "COLOR": ("COLOR_0", "<4B", (255, 255, 255, 255)),
+}
+
+
+def align(blob):
+    while len(blob) % ALIGN:
+        blob.append(0)
+
+
+def source_stamp(path, mesh=False):
+    """Size and mtime the game compares entries against (bsf_asset_pack_entry_stale)"""
+    st = os.stat(path)
+    size, mtime = st.st_size, int(st.st_mtime)
+    bin_path = os.path.splitext(path)[0] + ".bin"
+    if mesh and os.path.exists(bin_path):
+        st = os.stat(bin_path)
+        size, mtime = size + st.st_size, max(mtime, int(st.st_mtime))
+    return size, mtime
+
+
+#=== Images ===#
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def decode_png(path):
+    data = open(path, "rb").read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("not a png")
+    pos, idat, palette, trns = 8, bytearray(), None, None
+    while pos < len(data):
+        ln, kind = struct.unpack_from(">I4s", data, pos)
+        chunk = data[pos + 8:pos + 8 + ln]
+        pos += 12 + ln
+        if kind == b"IHDR":
+            w, h, depth, ctype, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            palette = chunk
+        elif kind == b"tRNS":
+            trns = chunk
+        elif kind == b"IDAT":
+            idat.extend(chunk)
+        elif kind == b"IEND":
+            break
+    if interlace or depth not in (8, 16) or (ctype == 3 and depth != 8):
+        raise ValueError("unsupported png (interlaced or bit depth %d)" % depth)
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[ctype]
+    bpp = channels * depth // 8
+    stride = w * bpp
+    raw = zlib.decompress(bytes(idat))
+    rows, prev = [], bytearray(stride)
+    for y in range(h):
+        f = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        if f == 1:
+            for i in range(bpp, stride):
+                line[i] = (line[i] + line[i - bpp]) & 0xFF
+        elif f == 2:
+            line = bytearray((a + b) & 0xFF for a, b in zip(line, prev))
+        elif f == 3:
+            for i in range(stride):
+                left = line[i - bpp] if i >= bpp else 0
+                line[i] = (line[i] + ((left + prev[i]) >> 1)) & 0xFF
+        elif f == 4:
+            for i in range(stride):
+                left = line[i - bpp] if i >= bpp else 0
+                up_left = prev[i - bpp] if i >= bpp else 0
+                line[i] = (line[i] + paeth(left, prev[i], up_left)) & 0xFF
+        rows.append(line)
+        prev = line
+
+    out = bytearray(w * h * 4)
+    o = 0
+    for line in rows:
+        if depth == 16:
+            line = line[0::2]
+        for x in range(w):
+            if ctype == 6:
+                px = line[x * 4:x * 4 + 4]
+            elif ctype == 2:
+                px = line[x * 3:x * 3 + 3] + b"\xff"
+            elif ctype == 0:
+                px = bytes((line[x],) * 3) + b"\xff"
+            elif ctype == 4:
+                px = bytes((line[x * 2],) * 3) + bytes((line[x * 2 + 1],))
+            else:
+                i = line[x]
+                alpha = trns[i] if trns and i < len(trns) else 255
+                px = palette[i * 3:i * 3 + 3] + bytes((alpha,))
+            out[o:o + 4] = px
+            o += 4
+    return w, h, bytes(out)
+
+
+def strip_opaque_alpha(pixels):
+    """RGB rows if every alpha is 255, else None"""
+    if any(a != 255 for a in pixels[3::4]):
+        return None
+    out = bytearray(len(pixels) // 4 * 3)
+    out[0::3], out[1::3], out[2::3] = pixels[0::4], pixels[1::4], pixels[2::4]
+    return bytes(out)
+
+
+def decode_image(path):
+    if path.lower().endswith(".png"):
+        return decode_png(path)
+    try:
+        from PIL import Image
+    except ImportError:
+        raise ValueError("jpeg needs Pillow")
+    img = Image.open(path).convert("RGBA")
+    return img.width, img.height, img.tobytes()
+
+
+#=== Meshes ===#
+
+def read_accessor(gltf, bins, idx):
+    acc = gltf["accessors"][idx]
+    view = gltf["bufferViews"][acc["bufferView"]]
+    n = COMPONENTS[acc["type"]]
+    fmt = FORMATS[acc["componentType"]]
+    size = struct.calcsize(fmt) * n
+    stride = view.get("byteStride", size)
+    base = view.get("byteOffset", 0) + acc.get("byteOffset", 0)
+    data = bins[view["buffer"]]
+    out = []
+    for i in range(acc["count"]):
+        v = struct.unpack_from("<" + fmt * n, data, base + i * stride)
+        if acc.get("normalized") and fmt != "f":
+            v = tuple(c / float((1 << (8 * struct.calcsize(fmt))) - 1) for c in v)
+        out.append(v if n > 1 else v[0])
+    return out
+
+
+def pipeline_layout(path):
+    """Semantic attributes (mesh_layout) and index size of a .sf pipeline"""
+    text = re.sub(r"//[^\n]*", "", open(path).read())
+    isize = 4 if re.search(r"index_buffer_element_size\s*:\s*UINT32", text) else 2
+    attrs = re.search(r"attributes\s*\{([^}]*)\}", text).group(1)
+    layout = [a for a in re.findall(r"(\w+)\s*:", attrs) if a in SEMANTICS]
+    return layout, isize
+
+
+def bake_mesh(path, layout, isize):
+    gltf = json.load(open(path))
+    src_dir = os.path.dirname(path)
+    bins = [open(os.path.join(src_dir, b["uri"]), "rb").read() for b in gltf["buffers"]]
+
+    prims = []
+    mn, mx = [math.inf] * 3, [-math.inf] * 3
+    for mesh in gltf["meshes"]:
+        for prim in mesh["primitives"]:
+            attrs = prim["attributes"]
+            streams = []
+            for sem in layout:
+                key, fmt, default = SEMANTICS[sem]
+                values = read_accessor(gltf, bins, attrs[key]) if key in attrs else None
+                if values and sem == "COLOR":
+                    values = [tuple(int(round(min(max(c, 0.0), 1.0) * 255)) for c in (v + (1.0,))[:4]) for v in values]
+                streams.append((fmt, values, default))
+            pos = read_accessor(gltf, bins, attrs["POSITION"])
+            for p in pos:
+                mn = [min(a, b) for a, b in zip(mn, p)]
+                mx = [max(a, b) for a, b in zip(mx, p)]
+
+            verts = bytearray()
+            for i in range(len(pos)):
+                for fmt, values, default in streams:
+                    verts.extend(struct.pack(fmt, *(values[i] if values else default)))
+            idx = read_accessor(gltf, bins, prim["indices"]) if "indices" in prim else list(range(len(pos)))
+            indices = struct.pack("<%d%s" % (len(idx), "I" if isize == 4 else "H"), *idx)
+            prims.append((bytes(verts), indices, len(idx)))
+
+    # Same sphere as bsf_graphics_mesh_bounds_from_file
+    c = [(a + b) * 0.5 for a, b in zip(mn, mx)]
+    r = math.sqrt(sum((b - a) ** 2 for a, b in zip(c, mx)))
+
+    head = struct.calcsize(MESH_FMT) + struct.calcsize(PRIM_FMT) * len(prims)
+    data = bytearray(head)
+    align(data)
+    table = []
+    for verts, indices, count in prims:
+        vo = len(data)
+        data.extend(verts)
+        align(data)
+        io = len(data)
+        data.extend(indices)
+        align(data)
+        table.append(struct.pack(PRIM_FMT, vo, len(verts), io, len(indices), count, 0, 0, 0))
+    header = struct.pack(MESH_FMT, c[0], c[1], c[2], r, ",".join(layout).encode(), isize, len(prims), 0, 0)
+    data[0:head] = header + b"".join(table)
+    return bytes(data)
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__)
+        return 1
+
+    asset_dir, dst = sys.argv[1], sys.argv[2]
+    mapping = dict(arg.split("=", 1) for arg in sys.argv[3:])
+
+    entries = []    # (path, type, width, height, comps, payload, source stamp)
+    for name in sorted(os.listdir(os.path.join(asset_dir, "textures"))):
+        rel = "textures/" + name
+        try:
+            w, h, pixels = decode_image(os.path.join(asset_dir, rel))
+        except ValueError as e:
+            print("skipped %s: %s" % (rel, e))
+            continue
+        # RGB rows must stay 4 byte aligned, gs uploads with the default unpack alignment
+        rgb = strip_opaque_alpha(pixels) if (w * 3) % 4 == 0 else None
+        comps = 3 if rgb else 4
+        entries.append((rel, TYPE_IMAGE, w, h, comps, rgb or pixels, source_stamp(os.path.join(asset_dir, rel))))
+        print("%s: %dx%d, %d comps" % (rel, w, h, comps))
+
+    for name in sorted(os.listdir(os.path.join(asset_dir, "meshes"))):
+        if not name.endswith(".gltf"):
+            continue
+        rel = "meshes/" + name
+        pip = mapping.get(rel, "pipelines/simple.sf")
+        layout, isize = pipeline_layout(os.path.join(asset_dir, pip))
+        payload = bake_mesh(os.path.join(asset_dir, rel), layout, isize)
+        entries.append((rel, TYPE_MESH, 0, 0, 0, payload, source_stamp(os.path.join(asset_dir, rel), mesh=True)))
+        print("%s: %s, %d bytes" % (rel, ",".join(layout), len(payload)))
+
+    fonts = re.compile(r"(.+\.ttf)\.(\d+)\.bsff$")
+    for name in sorted(os.listdir(os.path.join(asset_dir, "fonts"))):
+        m = fonts.match(name)
+        if not m:
+            continue
+        rel, ttf = "fonts/" + name, "fonts/" + m.group(1)
+        payload = open(os.path.join(asset_dir, rel), "rb").read()
+        if not os.path.exists(os.path.join(asset_dir, ttf)) or len(payload) < struct.calcsize(FONT_HEADER_FMT):
+            print("skipped %s: no ttf or truncated" % rel)
+            continue
+        # The game checks the ttf hash and gs_asset_font_t size itself
+        magic, version, _, pt, _, w, h = struct.unpack_from(FONT_HEADER_FMT, payload)
+        if magic != FONT_MAGIC or version != FONT_VERSION or pt != int(m.group(2)):
+            print("skipped %s: not a font atlas of this version" % rel)
+            continue
+        entries.append((ttf, TYPE_FONT, w, h, pt, payload, source_stamp(os.path.join(asset_dir, ttf))))
+        print("%s: %dpt, %dx%d atlas" % (ttf, pt, w, h))
+
+    blob = bytearray(struct.pack("<4I", MAGIC, VERSION, len(entries), 0))
+    blob.extend(bytes(struct.calcsize(ENTRY_FMT) * len(entries)))
+    align(blob)
+    table, stored, shared = [], {}, 0
+    for path, kind, w, h, comps, payload, (src_size, src_mtime) in entries:
+        offset = stored.get(payload)
+        if offset is None:
+            offset = stored[payload] = len(blob)
+            blob.extend(payload)
+            align(blob)
+        else:
+            shared += 1
+        table.append(struct.pack(ENTRY_FMT, path.encode(), kind, w, h, comps, offset, len(payload), src_size, src_mtime))
+    blob[16:16 + len(b"".join(table))] = b"".join(table)
+
+    open(dst, "wb").write(blob)
+    print("%s: %d entries (%d sharing a payload), %d bytes" % (dst, len(entries), shared, len(blob)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,266 @@
+#!/usr/bin/env python3
+"""
+cmd_replay.py: headless replay of command buffer captures (null backend, no GPU needed)
+
+    ./bin/App --capture frames.bsfc 600
+    python3 tools/cmd_replay.py frames.bsfc
+    python3 tools/cmd_replay.py frames.bsfc --json stats.json
+    python3 tools/cmd_replay.py frames.bsfc --baseline stats.json
+
+Every captured frame holds the scene and overlay command buffers exactly as they were handed to
+gs_graphics_command_buffer_submit. Commands are decoded following the opengl backend's encoding and
+counted instead of executed: draws, pipeline binds, vertex/index binds, textures, uniform bytes and
+buffer upload bytes, next to the encode time measured by the renderer.
+
+With --baseline, exits with 1 if mean draws or binds per frame grew over the baseline (plus --tolerance
+percent), so draw call regressions fail automated runs.
+
+The capture header carries the backend's opcode and bind type tables by name, so commands are decoded
+by name whatever their values. A capture naming an opcode or bind type missing from OPS/BINDS below (gs
+added one) is rejected up front, and any command or bind whose value isn't in the tables fails its frame.
+"""
+
+import argparse
+import json
+import struct
+import sys
+import time
+
+MAGIC = 0x43465342
+VERSION = 2
+HEADER_FMT = "<6I"          # bsf_capture_header_t
+CODE_FMT = "<32sI"          # bsf_capture_code_t
+
+# Opcodes of gs_graphics_impl.h (opengl) this replayer can decode, as named by bsf_capture_begin
+OPS = {"BEGIN_RENDER_PASS", "END_RENDER_PASS", "SET_VIEWPORT", "SET_VIEW_SCISSOR", "CLEAR",
+       "REQUEST_VERTEX_BUFFER_UPDATE", "REQUEST_INDEX_BUFFER_UPDATE", "REQUEST_UNIFORM_BUFFER_UPDATE",
+       "REQUEST_STORAGE_BUFFER_UPDATE", "REQUEST_TEXTURE_UPDATE", "BIND_PIPELINE", "APPLY_BINDINGS",
+       "DISPATCH_COMPUTE", "DRAW"}
+
+# gs_graphics_bind_type
+BINDS = {"VERTEX_BUFFER", "INDEX_BUFFER", "UNIFORM_BUFFER", "STORAGE_BUFFER", "IMAGE_BUFFER", "UNIFORM"}
+
+CLEAR_ACTION_SIZE = 20      # gs_graphics_clear_action_t: flag + color[4]
+
+
+class FormatError(Exception):
+    pass
+
+
+class Reader:
+    def __init__(self, data, size_t, ops, binds):
+        self.data, self.pos = data, 0
+        self.ops, self.binds = ops, binds
+        self.size_fmt = "<Q" if size_t == 8 else "<I"
+        self.size_len = size_t
+
+    def u32(self):
+        if self.pos + 4 > len(self.data):
+            raise FormatError("read past end of stream at %d" % self.pos)
+        v = struct.unpack_from("<I", self.data, self.pos)[0]
+        self.pos += 4
+        return v
+
+    def size(self):
+        if self.pos + self.size_len > len(self.data):
+            raise FormatError("read past end of stream at %d" % self.pos)
+        v = struct.unpack_from(self.size_fmt, self.data, self.pos)[0]
+        self.pos += self.size_len
+        return v
+
+    def skip(self, n):
+        if self.pos + n > len(self.data):
+            raise FormatError("skip past end of stream at %d" % self.pos)
+        self.pos += n
+
+
+def new_stats():
+    return {"draws": 0, "instances": 0, "pipeline_binds": 0, "vertex_binds": 0, "index_binds": 0,
+            "texture_binds": 0, "uniform_binds": 0, "uniform_bytes": 0, "upload_bytes": 0,
+            "passes": 0, "commands": 0}
+
+
+def decode_buffer_update(r, st, uniform=False):
+    r.u32()             # buffer id
+    r.u32()             # update type
+    r.size()            # offset
+    sz = r.size()
+    r.skip(sz)
+    st["uniform_bytes" if uniform else "upload_bytes"] += sz
+
+
+def decode_bindings(r, st):
+    for _ in range(r.u32()):
+        value = r.u32()
+        bind = r.binds.get(value)
+        if bind is None:
+            raise FormatError("unknown bind type %d at %d" % (value, r.pos - 4))
+        if bind == "VERTEX_BUFFER":
+            r.u32(); r.size(); r.u32()          # id, offset, data type
+            st["vertex_binds"] += 1
+        elif bind == "INDEX_BUFFER":
+            r.u32()
+            st["index_binds"] += 1
+        elif bind == "UNIFORM_BUFFER":
+            r.u32(); r.u32(); r.size(); r.size()    # id, binding, offset, range
+            st["uniform_binds"] += 1
+        elif bind == "STORAGE_BUFFER":
+            r.u32(); r.u32()
+        elif bind == "IMAGE_BUFFER":
+            r.u32(); r.u32(); r.u32()           # id, binding, access
+            st["texture_binds"] += 1
+        elif bind == "UNIFORM":
+            r.u32(); r.u32()                    # id, binding
+            sz = r.size()
+            r.skip(sz)
+            st["uniform_binds"] += 1
+            st["uniform_bytes"] += sz
+        else:
+            raise FormatError("undecodable bind type %s at %d" % (bind, r.pos - 4))
+
+
+def decode_stream(data, num_commands, size_t, ops, binds, st):
+    r = Reader(data, size_t, ops, binds)
+    for _ in range(num_commands):
+        value = r.u32()
+        op = ops.get(value)
+        if op is None:
+            raise FormatError("unknown opcode %d at %d" % (value, r.pos - 4))
+        if op == "BEGIN_RENDER_PASS":
+            r.u32()
+            st["passes"] += 1
+        elif op == "END_RENDER_PASS":
+            pass
+        elif op in ("SET_VIEWPORT", "SET_VIEW_SCISSOR"):
+            r.skip(16)
+        elif op == "CLEAR":
+            r.skip(r.u32() * CLEAR_ACTION_SIZE)
+        elif op in ("REQUEST_VERTEX_BUFFER_UPDATE", "REQUEST_INDEX_BUFFER_UPDATE", "REQUEST_STORAGE_BUFFER_UPDATE"):
+            decode_buffer_update(r, st)
+        elif op == "REQUEST_UNIFORM_BUFFER_UPDATE":
+            decode_buffer_update(r, st, uniform=True)
+        elif op == "BIND_PIPELINE":
+            r.u32()
+            st["pipeline_binds"] += 1
+        elif op == "APPLY_BINDINGS":
+            decode_bindings(r, st)
+        elif op == "DISPATCH_COMPUTE":
+            r.skip(12)
+        elif op == "DRAW":
+            r.u32()                 # start
+            r.u32()                 # count
+            instances = r.u32()
+            r.skip(12)              # base vertex, range
+            st["draws"] += 1
+            st["instances"] += max(1, instances)
+        else:
+            # Texture updates carry a full texture desc, never recorded per frame by the game
+            raise FormatError("unsupported opcode %s at %d" % (op, r.pos - 4))
+        st["commands"] += 1
+    if r.pos != len(data):
+        raise FormatError("decoded %d of %d bytes" % (r.pos, len(data)))
+
+
+def read_codes(data, pos, count, known, kind):
+    """Value to name table of the capture, every name must be one this replayer knows."""
+    codes = {}
+    for _ in range(count):
+        if pos + struct.calcsize(CODE_FMT) > len(data):
+            raise FormatError("%s table runs past end of file" % kind)
+        name, value = struct.unpack_from(CODE_FMT, data, pos)
+        pos += struct.calcsize(CODE_FMT)
+        name = name.split(b"\0", 1)[0].decode("ascii")
+        if name not in known:
+            raise FormatError("capture uses %s %s (%d) unknown to this replayer" % (kind, name, value))
+        codes[value] = name
+    return codes, pos
+
+
+def replay(path):
+    data = open(path, "rb").read()
+    if len(data) < struct.calcsize(HEADER_FMT):
+        raise FormatError("%s is too short for a capture header" % path)
+    magic, version, count, size_t, op_count, bind_count = struct.unpack_from(HEADER_FMT, data, 0)
+    if magic != MAGIC or version != VERSION:
+        raise FormatError("%s is not a version %d capture" % (path, VERSION))
+
+    pos = struct.calcsize(HEADER_FMT)
+    ops, pos = read_codes(data, pos, op_count, OPS, "opcode")
+    binds, pos = read_codes(data, pos, bind_count, BINDS, "bind type")
+
+    frames = []
+    for _ in range(count):
+        fid, encode_ms, draws, instances, pbinds, mbinds, streams = struct.unpack_from("<If5I", data, pos)
+        pos += 28
+        st = new_stats()
+        st.update(frame=fid, encode_ms=encode_ms, scene_draws=draws)
+        t0 = time.perf_counter()
+        for _ in range(streams):
+            num_commands, size = struct.unpack_from("<2I", data, pos)
+            pos += 8
+            try:
+                decode_stream(data[pos:pos + size], num_commands, size_t, ops, binds, st)
+            except FormatError as e:
+                raise FormatError("frame %d: format mismatch, %s" % (fid, e))
+            pos += size
+        st["decode_ms"] = (time.perf_counter() - t0) * 1000.0
+        if st["draws"] < draws:
+            raise FormatError("frame %d: decoded %d draws, renderer counted %d in scene alone" % (fid, st["draws"], draws))
+        frames.append(st)
+    return frames
+
+
+def summarize(frames):
+    keys = [k for k in new_stats()] + ["encode_ms", "decode_ms"]
+    n = max(1, len(frames))
+    mean = {k: sum(f[k] for f in frames) / n for k in keys}
+    peak = {k: max((f[k] for f in frames), default=0) for k in keys}
+    return {"frames": len(frames), "mean": mean, "max": peak}
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Replay a bsf command capture without a GPU")
+    ap.add_argument("capture")
+    ap.add_argument("--json", help="write summary to file")
+    ap.add_argument("--baseline", help="summary json to compare against")
+    ap.add_argument("--tolerance", type=float, default=0.0, help="percent growth allowed over baseline")
+    ap.add_argument("--frames", action="store_true", help="print every frame")
+    args = ap.parse_args()
+
+    try:
+        frames = replay(args.capture)
+    except FormatError as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 2
+
+    if args.frames:
+        print("%6s %6s %9s %6s %6s %6s %9s %9s %8s" % ("frame", "draws", "instances", "pips", "vbs", "texs",
+              "uniforms", "uploads", "encode"))
+        for f in frames:
+            print("%6d %6d %9d %6d %6d %6d %9d %9d %7.3fms" % (f["frame"], f["draws"], f["instances"],
+                  f["pipeline_binds"], f["vertex_binds"], f["texture_binds"], f["uniform_bytes"],
+                  f["upload_bytes"], f["encode_ms"]))
+
+    summary = summarize(frames)
+    print("%s: %d frames" % (args.capture, summary["frames"]))
+    for k in ("draws", "instances", "pipeline_binds", "vertex_binds", "index_binds", "texture_binds",
+              "uniform_binds", "uniform_bytes", "upload_bytes", "encode_ms", "decode_ms"):
+        print("  %-15s mean %10.2f  max %10.2f" % (k, summary["mean"][k], summary["max"][k]))
+
+    if args.json:
+        json.dump(summary, open(args.json, "w"), indent=4)
+
+    if args.baseline:
+        base = json.load(open(args.baseline))
+        failed = False
+        for k in ("draws", "pipeline_binds", "vertex_binds", "texture_binds"):
+            limit = base["mean"][k] * (1.0 + args.tolerance / 100.0)
+            if summary["mean"][k] > limit:
+                print("regression: mean %s %.2f over baseline %.2f" % (k, summary["mean"][k], base["mean"][k]))
+                failed = True
+        return 1 if failed else 0
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""
+mesh_simplify.py: offline LOD generation for gltf meshes (vertex clustering)
+
+    python3 tools/mesh_simplify.py assets/meshes/brain.gltf assets/meshes/brain_lod1.gltf 48
+    python3 tools/mesh_simplify.py assets/meshes/brain.gltf assets/meshes/brain_lod2.gltf 16
+
+Vertices of each primitive are snapped to a grid with <cells> divisions along the longest
+axis of the mesh, merged per cell (averaged position/normal, first uv) and degenerate
+triangles are dropped. Materials, textures and nodes are kept as is, so the result loads
+with the same pipeline and material as the source mesh.
+"""
+
+import json
+import math
+import os
+import struct
+import sys
+
+COMPONENTS = {"SCALAR": 1, "VEC2": 2, "VEC3": 3, "VEC4": 4}
+FORMATS = {5121: "B", 5123: "H", 5125: "I", 5126: "f"}
+
+
+def read_accessor(gltf, bins, idx):
+    acc = gltf["accessors"][idx]
+    view = gltf["bufferViews"][acc["bufferView"]]
+    n = COMPONENTS[acc["type"]]
+    fmt = FORMATS[acc["componentType"]]
+    size = struct.calcsize(fmt) * n
+    stride = view.get("byteStride", size)
+    base = view.get("byteOffset", 0) + acc.get("byteOffset", 0)
+    data = bins[view["buffer"]]
+    out = []
+    for i in range(acc["count"]):
+        v = struct.unpack_from("<" + fmt * n, data, base + i * stride)
+        out.append(v if n > 1 else v[0])
+    return out
+
+
+def simplify(pos, nrm, uv, idx, cell, origin):
+    clusters = {}
+    remap = []
+    for i, p in enumerate(pos):
+        key = tuple(int(math.floor((p[c] - origin[c]) / cell)) for c in range(3))
+        if key not in clusters:
+            clusters[key] = [len(clusters), [0.0] * 3, [0.0] * 3, uv[i] if uv else None, 0]
+        cl = clusters[key]
+        for c in range(3):
+            cl[1][c] += p[c]
+            if nrm:
+                cl[2][c] += nrm[i][c]
+        cl[4] += 1
+        remap.append(cl[0])
+
+    verts = [None] * len(clusters)
+    for cl in clusters.values():
+        p = [x / cl[4] for x in cl[1]]
+        n = cl[2]
+        ln = math.sqrt(sum(x * x for x in n)) or 1.0
+        verts[cl[0]] = (p, [x / ln for x in n], cl[3])
+
+    tris = set()
+    out = []
+    for t in range(0, len(idx), 3):
+        a, b, c = remap[idx[t]], remap[idx[t + 1]], remap[idx[t + 2]]
+        if a == b or b == c or a == c:
+            continue
+        key = tuple(sorted((a, b, c)))
+        if key in tris:
+            continue
+        tris.add(key)
+        out.extend((a, b, c))
+    return verts, out
+
+
+def main():
+    if len(sys.argv) != 4:
+        print(__doc__)
+        return 1
+
+    src, dst, cells = sys.argv[1], sys.argv[2], int(sys.argv[3])
+    gltf = json.load(open(src))
+    src_dir = os.path.dirname(src)
+    bins = [open(os.path.join(src_dir, b["uri"]), "rb").read() for b in gltf["buffers"]]
+
+    # Grid from extents of whole mesh so all primitives share cells
+    mn, mx = [math.inf] * 3, [-math.inf] * 3
+    for mesh in gltf["meshes"]:
+        for prim in mesh["primitives"]:
+            acc = gltf["accessors"][prim["attributes"]["POSITION"]]
+            mn = [min(a, b) for a, b in zip(mn, acc["min"])]
+            mx = [max(a, b) for a, b in zip(mx, acc["max"])]
+    cell = max(b - a for a, b in zip(mn, mx)) / cells
+
+    blob = bytearray()
+    views, accessors = [], []
+
+    def push(data, target, count, ctype, atype, bounds=None):
+        while len(blob) % 4:
+            blob.append(0)
+        views.append({"buffer": 0, "byteOffset": len(blob), "byteLength": len(data), "target": target})
+        blob.extend(data)
+        acc = {"bufferView": len(views) - 1, "componentType": ctype, "count": count, "type": atype}
+        if bounds:
+            acc["min"], acc["max"] = bounds
+        accessors.append(acc)
+        return len(accessors) - 1
+
+    src_verts = dst_verts = 0
+    for mesh in gltf["meshes"]:
+        for prim in mesh["primitives"]:
+            attrs = prim["attributes"]
+            pos = read_accessor(gltf, bins, attrs["POSITION"])
+            nrm = read_accessor(gltf, bins, attrs["NORMAL"]) if "NORMAL" in attrs else None
+            uv = read_accessor(gltf, bins, attrs["TEXCOORD_0"]) if "TEXCOORD_0" in attrs else None
+            idx = read_accessor(gltf, bins, prim["indices"]) if "indices" in prim else list(range(len(pos)))
+            verts, tris = simplify(pos, nrm, uv, idx, cell, mn)
+            src_verts += len(pos)
+            dst_verts += len(verts)
+
+            p = [v[0] for v in verts]
+            bounds = ([min(v[c] for v in p) for c in range(3)], [max(v[c] for v in p) for c in range(3)])
+            new_attrs = {"POSITION": push(b"".join(struct.pack("<3f", *v) for v in p), 34962, len(p), 5126, "VEC3", bounds)}
+            if nrm:
+                new_attrs["NORMAL"] = push(b"".join(struct.pack("<3f", *v[1]) for v in verts), 34962, len(verts), 5126, "VEC3")
+            if uv:
+                new_attrs["TEXCOORD_0"] = push(b"".join(struct.pack("<2f", *v[2]) for v in verts), 34962, len(verts), 5126, "VEC2")
+
+            # Keep index size of source so the pipeline's index_buffer_element_size still matches
+            ictype = gltf["accessors"][prim["indices"]]["componentType"] if "indices" in prim else 5125
+            ifmt = FORMATS[ictype]
+            prim["indices"] = push(struct.pack("<%d%s" % (len(tris), ifmt), *tris), 34963, len(tris), ictype, "SCALAR")
+            prim["attributes"] = new_attrs
+
+    bin_name = os.path.splitext(os.path.basename(dst))[0] + ".bin"
+    gltf["accessors"] = accessors
+    gltf["bufferViews"] = views
+    gltf["buffers"] = [{"byteLength": len(blob), "uri": bin_name}]
+    gltf["asset"]["generator"] = "bsf mesh_simplify.py"
+
+    open(os.path.join(os.path.dirname(dst), bin_name), "wb").write(blob)
+    json.dump(gltf, open(dst, "w"), indent=4)
+    print("%s: %d -> %d verts" % (dst, src_verts, dst_verts))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())